@@ -0,0 +1,59 @@
+import mmap
+import struct
+from typing import Dict, List
+
+# Header of the binary assignment file written by team_maker_api.exe --output=binary
+# (see cpp/include/AssignmentFile.h): magic, version, persons, teams, categories and the
+# offsets of the sections, all little-endian
+HEADER = struct.Struct("<4sIQII8Q")
+MAGIC = b"TMAS"
+VERSION = 1
+
+class AssignmentFile:
+    """Memory-mapped view of a binary assignment file. The columns are typed memoryviews over
+    the mapping, so nothing is copied until it is read."""
+
+    def __init__(self, path: str):
+        with open(path, "rb") as f:
+            self._map = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+        (magic, version, self.num_persons, self.num_teams, num_categories,
+         team_of, team_offsets, members, scores, categories,
+         name_offsets, names, file_size) = HEADER.unpack_from(self._map, 0)
+        if magic != MAGIC or version > VERSION:
+            raise ValueError("Not a supported team assignment file")
+        if file_size > len(self._map):
+            raise ValueError("Truncated team assignment file")
+
+        view = memoryview(self._map)
+        self.team_of = view[team_of:team_of + 4 * self.num_persons].cast("i")
+        self.team_offsets = view[team_offsets:team_offsets + 8 * (self.num_teams + 1)].cast("Q")
+        num_members = self.team_offsets[self.num_teams]
+        self.members = view[members:members + 4 * num_members].cast("i")
+        self.scores = view[scores:scores + 8 * self.num_teams].cast("d")
+        self.category_totals: Dict[int, memoryview] = {}
+        offset = categories
+        for _ in range(num_categories):
+            index = struct.unpack_from("<i", self._map, offset)[0]
+            self.category_totals[index] = view[offset + 8:offset + 8 + 8 * self.num_teams].cast("d")
+            offset += 8 + 8 * self.num_teams
+        self.has_names = name_offsets != 0
+        if self.has_names:
+            self._name_offsets = view[name_offsets:name_offsets + 8 * (self.num_persons + 1)].cast("Q")
+        self._names = names
+
+    def name(self, person: int) -> str:
+        """Name of a roster row; files written without names need the roster instead"""
+        if not self.has_names:
+            raise ValueError("The assignment file was written without names")
+        start = self._names + self._name_offsets[person]
+        end = self._names + self._name_offsets[person + 1]
+        return self._map[start:end].decode("utf-8")
+
+    def team_members(self, team: int) -> List[str]:
+        """Names of the members of a team (0-based), in listing order"""
+        start, end = self.team_offsets[team], self.team_offsets[team + 1]
+        return [self.name(person) for person in self.members[start:end]]
+
+    def teams(self) -> List[dict]:
+        """The teams in the JSON shape of team_maker_api.exe"""
+        return [{"team_number": team + 1, "members": self.team_members(team)} for team in range(self.num_teams)]
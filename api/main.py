@@ -2,13 +2,36 @@ import os
 from fastapi import FastAPI, UploadFile, File, Form, HTTPException
 from fastapi.middleware.cors import CORSMiddleware
 from fastapi.staticfiles import StaticFiles
-from fastapi.responses import FileResponse, JSONResponse
+from fastapi.responses import FileResponse, JSONResponse, StreamingResponse
+from starlette.background import BackgroundTask
 import subprocess
 import tempfile
 import shutil
 import json
+import asyncio
+import gzip
 from typing import List, Optional
 from pydantic import BaseModel
+from shared_output import run_with_shared_output, shared_memory_available
+from starlette.concurrency import run_in_threadpool
+
+try:
+    # Native module built from cpp/src/team_maker_python.cpp; without it every request runs
+    # team_maker_api.exe
+    import team_maker
+except ImportError:
+    team_maker = None
+
+# Seconds between status checks of /jobs/{id}/events
+JOB_POLL_SECONDS = 0.25
+
+# Teams of repeatable requests (deterministic strategies, or random ones with a seed) are kept
+# here and in memory, within RESULT_CACHE_BYTES each, and reused while the roster is unchanged
+RESULT_CACHE_DIR = os.path.join(tempfile.gettempdir(), "team_maker_cache")
+RESULT_CACHE_BYTES = 256 << 20
+os.makedirs(RESULT_CACHE_DIR, exist_ok=True)
+if team_maker is not None:
+    team_maker.configure_cache(RESULT_CACHE_BYTES, RESULT_CACHE_DIR)
 
 app = FastAPI(title="Team Maker API")
 
@@ -26,11 +49,36 @@ class CategoryWeight(BaseModel):
     weight: float
     name: str
 
+class TeamConstraints(BaseModel):
+    together: List[List[str]] = []  # groups of names that must share a team
+    apart: List[List[str]] = []  # pairs of names that must never share a team
+
 class TeamGenerationRequest(BaseModel):
     num_teams: int
-    generation_type: str  # 'random', 'categorical', 'random_categorical'
+    generation_type: str  # any strategy listed by /strategies/, e.g. 'random', 'categorical'
     categories: Optional[List[CategoryWeight]] = None
     file_path: str
+    constraints: Optional[TeamConstraints] = None
+    min_team_size: Optional[int] = None
+    max_team_size: Optional[int] = None
+    team_capacities: Optional[List[int]] = None  # exact size of every team
+    diversity_categories: Optional[List[int]] = None  # text categories to mix evenly across teams
+    include_metrics: bool = False  # also return per-category balance statistics
+    threads: Optional[int] = None  # refinement threads for strategies that support them
+    deadline_ms: Optional[float] = None  # wall-clock budget for anytime strategies
+    iterations: Optional[int] = None  # annealing iterations per thread; default 30 per movable person, at least 200000
+    jitter: Optional[float] = None  # random_categorical: sort noise in score standard deviations
+    seed: Optional[int] = None  # random strategies: same seed and input give the same teams
+    stream: bool = False  # stream every better assignment as NDJSON
+    output_format: str = "json"  # 'binary' returns the assignment file (see api/assignment_file.py)
+    include_names: bool = False  # binary: store the names in the file too
+    fields: Optional[List[str]] = None  # json: any of 'members', 'size', 'score' (default: members)
+    team_offset: int = 0  # json: first team to return, counting from 0
+    team_limit: Optional[int] = None  # json: teams to return from team_offset
+    member_limit: Optional[int] = None  # json: members to list per team
+
+class TeamJobRequest(TeamGenerationRequest):
+    priority: int = 0  # queued jobs with a higher priority run first
 
 class SearchByCategoryRequest(BaseModel):
     file_path: str
@@ -38,6 +86,141 @@ class SearchByCategoryRequest(BaseModel):
     num_teams: int
     category_index: int
     categories: List[CategoryWeight]
+    top_k: Optional[int] = None  # only return the k best teams
+    constraints: Optional[TeamConstraints] = None
+    min_team_size: Optional[int] = None
+    max_team_size: Optional[int] = None
+    team_capacities: Optional[List[int]] = None
+    diversity_categories: Optional[List[int]] = None
+
+class PreviousTeam(BaseModel):
+    team_number: int
+    members: List[str]
+
+class TeamRebalanceRequest(BaseModel):
+    file_path: str  # the updated roster
+    generation_type: str  # 'categorical' or 'random_categorical'
+    categories: List[CategoryWeight]
+    previous_teams: List[PreviousTeam]
+    constraints: Optional[TeamConstraints] = None
+    min_team_size: Optional[int] = None
+    max_team_size: Optional[int] = None
+    team_capacities: Optional[List[int]] = None
+    diversity_categories: Optional[List[int]] = None
+
+class TeamQueryRequest(BaseModel):
+    file_path: str
+    generation_type: str
+    num_teams: int
+    categories: List[CategoryWeight]  # used to generate the teams
+    query_type: str  # 'top', 'near-mean' or 'person'
+    k: Optional[int] = 10  # top: number of teams
+    query_weights: Optional[List[CategoryWeight]] = None  # top: weighted combination to rank by
+    category_index: Optional[int] = None  # near-mean: category to compare
+    tolerance: Optional[float] = 0.05  # near-mean: allowed relative distance from the mean
+    name: Optional[str] = None  # person: name to look up
+    constraints: Optional[TeamConstraints] = None
+    min_team_size: Optional[int] = None
+    max_team_size: Optional[int] = None
+    team_capacities: Optional[List[int]] = None
+    diversity_categories: Optional[List[int]] = None
+
+class TeamSweepRequest(BaseModel):
+    file_path: str
+    num_teams: int
+    categories: List[int]  # category indices the weights apply to
+    weight_vectors: List[List[float]]  # one weight per category in every vector
+    threads: Optional[int] = None
+
+class TeamHierarchyRequest(BaseModel):
+    file_path: str
+    levels: List[int]  # number of groups per parent at every level, e.g. [4, 3, 2]
+    categories: Optional[List[CategoryWeight]] = None
+    diversity_categories: Optional[List[int]] = None
+    threads: Optional[int] = None
+    include_metrics: Optional[bool] = False
+
+def write_constraints_file(constraints: Optional[TeamConstraints]) -> Optional[str]:
+    """Write constraints to a new temporary file in the format read by team_maker_api.exe; every
+    request gets its own file, which the caller removes with remove_file() once it has been read"""
+    if constraints is None or (not constraints.together and not constraints.apart):
+        return None
+    for pair in constraints.apart:
+        if len(pair) != 2:
+            raise HTTPException(status_code=400, detail="Each keep-apart constraint must name exactly two people")
+    fd, constraints_path = tempfile.mkstemp(suffix=".txt")
+    with os.fdopen(fd, "w", encoding="utf-8") as f:
+        for group in constraints.together:
+            f.write("together," + ",".join(group) + "\n")
+        for pair in constraints.apart:
+            f.write("apart," + ",".join(pair) + "\n")
+    return constraints_path
+
+def remove_file(path: Optional[str]):
+    """Delete a temporary file written for one request, if there is one"""
+    if path:
+        try:
+            os.unlink(path)
+        except FileNotFoundError:
+            pass
+
+def generation_options(request) -> List[str]:
+    """Team size bound and diversity options for team_maker_api.exe"""
+    options = []
+    if request.min_team_size is not None:
+        options.append(f"--min-size={request.min_team_size}")
+    if request.max_team_size is not None:
+        options.append(f"--max-size={request.max_team_size}")
+    if request.team_capacities:
+        options.append("--capacities=" + ",".join(str(c) for c in request.team_capacities))
+    if request.diversity_categories:
+        options.append("--diversity=" + ",".join(str(c) for c in request.diversity_categories))
+    return options
+
+def request_constraints_file(request: TeamGenerationRequest) -> Optional[str]:
+    """Constraints file of a generation request; constraints only apply with categories"""
+    return write_constraints_file(request.constraints) if request.categories else None
+
+def strategy_options(request: TeamGenerationRequest, constraints_path: Optional[str]) -> List[str]:
+    """Constraint, team size, diversity and optimizer options of a generation request for
+    team_maker_api.exe"""
+    options = []
+    if constraints_path:
+        options.append(f"--constraints={constraints_path}")
+    options.extend(generation_options(request))
+    if request.threads is not None:
+        options.append(f"--threads={request.threads}")
+    if request.deadline_ms is not None:
+        options.append(f"--deadline-ms={request.deadline_ms}")
+    if request.iterations is not None:
+        options.append(f"--iterations={request.iterations}")
+    if request.jitter is not None:
+        options.append(f"--jitter={request.jitter}")
+    if request.seed is not None:
+        options.append(f"--seed={request.seed}")
+    return options
+
+def projection_options(request: TeamGenerationRequest) -> List[str]:
+    """Options of team_maker_api.exe selecting the fields, teams and members it prints"""
+    options = []
+    if request.fields is not None:
+        options.append(f"--fields={','.join(request.fields)}")
+    if request.team_offset:
+        options.append(f"--team-offset={request.team_offset}")
+    if request.team_limit is not None:
+        options.append(f"--team-limit={request.team_limit}")
+    if request.member_limit is not None:
+        options.append(f"--member-limit={request.member_limit}")
+    return options
+
+def module_options(command: List[str]) -> dict:
+    """The --name=value options of a team_maker_api.exe command, as team_maker.generate() options"""
+    options = {}
+    for argument in command:
+        if argument.startswith("--"):
+            name, _, value = argument[2:].partition("=")
+            options[name] = value
+    return options
     
 @app.post("/upload-csv/")
 async def upload_csv(file: UploadFile = File(...)):
@@ -50,20 +233,37 @@ async def upload_csv(file: UploadFile = File(...)):
         with open(file_path, "wb") as buffer:
             shutil.copyfileobj(file.file, buffer)
         
+        # Arrow IPC and Parquet files are recognised by their magic bytes and kept as they are
+        with open(file_path, "rb") as f:
+            magic = f.read(6)
+        columnar_extension = ".arrow" if magic == b"ARROW1" else ".parquet" if magic[:4] == b"PAR1" else None
+        # Gzip-compressed CSV files stay compressed; the C++ loader inflates them while parsing
+        compressed = magic[:2] == b"\x1f\x8b"
+        if columnar_extension or compressed:
+            renamed_path = os.path.join(temp_dir, "uploaded_data" + (columnar_extension or ".csv.gz"))
+            os.replace(file_path, renamed_path)
+            file_path = renamed_path
+        
         # Verify CSV is properly formatted - basic check
         try:
-            with open(file_path, 'r', encoding='utf-8') as f:
-                first_line = f.readline().strip()
-                if not first_line or ',' not in first_line:
-                    return JSONResponse(
-                        status_code=400,
-                        content={"error": "Invalid CSV format. File must contain comma-separated headers."}
-                    )
+            if not columnar_extension:
+                with (gzip.open(file_path, 'rt', encoding='utf-8') if compressed else open(file_path, 'r', encoding='utf-8')) as f:
+                    first_line = f.readline().strip()
+                    if not first_line or ',' not in first_line:
+                        return JSONResponse(
+                            status_code=400,
+                            content={"error": "Invalid CSV format. File must contain comma-separated headers."}
+                        )
         except UnicodeDecodeError:
             return JSONResponse(
                 status_code=400,
                 content={"error": "Invalid file encoding. Please use UTF-8."}
             )
+        except (OSError, EOFError):
+            return JSONResponse(
+                status_code=400,
+                content={"error": "Invalid gzip file."}
+            )
         
         # Determine the base directory (handles both local and deployed environments)
         base_dir = os.getcwd()
@@ -146,8 +346,44 @@ async def upload_csv(file: UploadFile = File(...)):
             content={"error": f"Failed to process the file: {str(e)}"}
         )
 
+@app.get("/strategies/")
+async def list_strategies():
+    try:
+        # Determine the base directory (handles both local and deployed environments)
+        base_dir = os.getcwd()
+        bin_dir = os.path.join(base_dir, "bin")
+        
+        # Handle case where we're in the API directory locally
+        if os.path.basename(base_dir) == "api":
+            bin_dir = os.path.join(os.path.dirname(base_dir), "bin")
+        
+        cpp_exec_path = os.path.join(bin_dir, "team_maker_api.exe")
+        
+        # Run the executable
+        result = subprocess.run(
+            [cpp_exec_path, "strategies"],
+            capture_output=True,
+            text=True
+        )
+        
+        if result.returncode != 0:
+            return JSONResponse(
+                status_code=400,
+                content={"error": f"Error listing strategies: {result.stderr}"}
+            )
+        
+        return {
+            "strategies": json.loads(result.stdout)
+        }
+    except Exception as e:
+        return JSONResponse(
+            status_code=500,
+            content={"error": f"Failed to list strategies: {str(e)}"}
+        )
+
 @app.post("/generate-teams/")
 async def generate_teams(request: TeamGenerationRequest):
+    constraints_path = None
     try:
         file_path = request.file_path
         # Check if file exists
@@ -168,17 +404,97 @@ async def generate_teams(request: TeamGenerationRequest):
         # Prepare command arguments
         command = [cpp_exec_path, file_path, "generate", request.generation_type, str(request.num_teams)]
         
-        if request.generation_type in ["categorical", "random_categorical"]:
-            if not request.categories or len(request.categories) == 0:
-                raise HTTPException(status_code=400, detail="Categories required for categorical team generation")
-            
-            # Add category indices and weights
+        # Add category indices and weights; the executable reports strategies that need them
+        if request.categories:
             category_indices = [str(cat.index) for cat in request.categories]
             weights = [str(cat.weight) for cat in request.categories]
             
             # Add to command
             command.append(",".join(category_indices))
             command.append(",".join(weights))
+
+        constraints_path = request_constraints_file(request)
+        command.extend(strategy_options(request, constraints_path))
+        command.append(f"--cache-dir={RESULT_CACHE_DIR}")
+        command.extend(projection_options(request))
+        if request.include_metrics:
+            command.append("--metrics")
+        
+        if request.output_format == "binary":
+            # Hand the assignment file over as is; the client memory-maps it instead of parsing JSON
+            fd, output_path = tempfile.mkstemp(suffix=".tma")
+            os.close(fd)
+            command.extend(["--output=binary", f"--output-file={output_path}"])
+            if request.include_names:
+                command.append("--output-names")
+            result = subprocess.run(command, capture_output=True, text=True)
+            if result.returncode != 0:
+                os.unlink(output_path)
+                return JSONResponse(
+                    status_code=400,
+                    content={"error": f"Error generating teams: {result.stderr}"}
+                )
+            return FileResponse(
+                output_path,
+                media_type="application/octet-stream",
+                filename="assignment.tma",
+                background=BackgroundTask(os.unlink, output_path)
+            )
+        elif request.output_format != "json":
+            return JSONResponse(
+                status_code=400,
+                content={"error": "output_format must be 'json' or 'binary'"}
+            )
+        
+        if team_maker is not None and not request.stream and not request.include_metrics:
+            # Generate in-process: no executable to start and no JSON to parse. The module
+            # releases the GIL, so other requests are served meanwhile.
+            category_indices = [cat.index for cat in request.categories or []]
+            weights = [cat.weight for cat in request.categories or []]
+            try:
+                teams = await run_in_threadpool(
+                    team_maker.generate, file_path, request.generation_type, request.num_teams,
+                    category_indices, weights, module_options(command)
+                )
+            except ValueError as e:
+                return JSONResponse(
+                    status_code=400,
+                    content={"error": f"Error generating teams: {str(e)}"}
+                )
+            return {
+                "teams": teams_response(teams)
+            }
+        
+        if request.stream:
+            # Forward each line (one assignment per line, the last marked "final") as it is printed
+            process = subprocess.Popen(command + ["--stream"], stdout=subprocess.PIPE, text=True)
+            stream_constraints_path, constraints_path = constraints_path, None
+            
+            def stream_lines():
+                try:
+                    for line in process.stdout:
+                        yield line
+                    process.wait()
+                finally:
+                    # The process has read the constraints by now, or was stopped by the client
+                    process.stdout.close()
+                    process.wait()
+                    remove_file(stream_constraints_path)
+            
+            return StreamingResponse(stream_lines(), media_type="application/x-ndjson")
+        
+        if shared_memory_available():
+            # The executable writes its JSON into shared memory; the bytes are streamed to the
+            # client from the mapping without being decoded or re-encoded
+            result, shared = run_with_shared_output(command)
+            if shared is None:
+                return JSONResponse(
+                    status_code=400,
+                    content={"error": f"Error generating teams: {result.stderr}"}
+                )
+            if request.include_metrics:
+                return StreamingResponse(shared.chunks(), media_type="application/json")
+            return StreamingResponse(shared.chunks(b'{"teams":', b"}"), media_type="application/json")
         
         # Run the executable
         result = subprocess.run(
@@ -193,17 +509,111 @@ async def generate_teams(request: TeamGenerationRequest):
                 content={"error": f"Error generating teams: {result.stderr}"}
             )
         
-        # Parse the output (teams)
-        teams = json.loads(result.stdout)
+        # Parse the output (teams, or teams and metrics)
+        output = json.loads(result.stdout)
+        if request.include_metrics:
+            return output
         
         return {
-            "teams": teams
+            "teams": output
         }
     except Exception as e:
         return JSONResponse(
             status_code=500,
             content={"error": f"Failed to generate teams: {str(e)}"}
         )
+    finally:
+        remove_file(constraints_path)
+
+def teams_response(teams: list) -> List[dict]:
+    """Member name lists as the team objects returned by /generate-teams/; projected teams
+    already come as those objects"""
+    return [team if isinstance(team, dict) else {"team_number": i + 1, "members": team} for i, team in enumerate(teams)]
+
+def require_job_queue():
+    if team_maker is None:
+        raise HTTPException(status_code=503, detail="Background jobs need the team_maker module; see running.txt")
+
+@app.post("/jobs/")
+async def submit_job(request: TeamJobRequest):
+    """Queue a generation request and return its job id at once. The team_maker module runs the
+    job on its own threads, so no worker waits for it; poll /jobs/{id} or follow
+    /jobs/{id}/events, then fetch /jobs/{id}/result."""
+    require_job_queue()
+    if not os.path.exists(request.file_path):
+        raise HTTPException(status_code=400, detail="File not found. Please upload the CSV file again.")
+    category_indices = [cat.index for cat in request.categories or []]
+    weights = [cat.weight for cat in request.categories or []]
+    # The module reads the constraints file before submit_job() returns
+    constraints_path = request_constraints_file(request)
+    try:
+        job_id = team_maker.submit_job(
+            request.file_path, request.generation_type, request.num_teams, category_indices, weights,
+            module_options(strategy_options(request, constraints_path)), request.priority
+        )
+    except ValueError as e:
+        return JSONResponse(status_code=400, content={"error": f"Error submitting job: {str(e)}"})
+    except RuntimeError as e:
+        return JSONResponse(status_code=503, content={"error": str(e)})
+    finally:
+        remove_file(constraints_path)
+    return team_maker.job_status(job_id)
+
+@app.get("/jobs/{job_id}")
+async def job_status(job_id: int):
+    """State, queue position and progress (improvements found, stddev of the team scores) of a job"""
+    require_job_queue()
+    try:
+        return team_maker.job_status(job_id)
+    except KeyError:
+        raise HTTPException(status_code=404, detail="No such job")
+
+@app.get("/jobs/{job_id}/events")
+async def job_events(job_id: int):
+    """The status of a job as NDJSON, one line whenever it changes until the job has finished"""
+    require_job_queue()
+    try:
+        status = team_maker.job_status(job_id)
+    except KeyError:
+        raise HTTPException(status_code=404, detail="No such job")
+
+    async def status_lines():
+        current = status
+        last = None
+        while True:
+            # Elapsed time changes on every poll; report it only along with real changes
+            changed = {k: v for k, v in current.items() if k != "elapsed_ms"}
+            if changed != last:
+                last = changed
+                yield json.dumps(current) + "\n"
+            if current["state"] not in ("queued", "running"):
+                return
+            await asyncio.sleep(JOB_POLL_SECONDS)
+            try:
+                current = team_maker.job_status(job_id)
+            except KeyError:
+                return
+
+    return StreamingResponse(status_lines(), media_type="application/x-ndjson")
+
+@app.get("/jobs/{job_id}/result")
+async def job_result(job_id: int):
+    """The status of a job and, once it has finished, its teams; finished jobs are forgotten
+    afterwards"""
+    require_job_queue()
+    try:
+        result = team_maker.job_result(job_id)
+    except KeyError:
+        raise HTTPException(status_code=404, detail="No such job")
+    if "teams" in result:
+        result["teams"] = teams_response(result["teams"])
+    return result
+
+@app.delete("/jobs/{job_id}")
+async def cancel_job(job_id: int):
+    """Cancel a queued job, or stop a running one at its next check"""
+    require_job_queue()
+    return {"cancelled": team_maker.cancel_job(job_id)}
 
 @app.post("/search-teams-by-category/")
 async def search_teams_by_category(request: SearchByCategoryRequest):
@@ -241,13 +651,23 @@ async def search_teams_by_category(request: SearchByCategoryRequest):
         # Add to command
         command.append(",".join(category_indices))
         command.append(",".join(weights))
+
+        constraints_path = write_constraints_file(request.constraints)
+        if constraints_path:
+            command.append(f"--constraints={constraints_path}")
+        command.extend(generation_options(request))
+        if request.top_k:
+            command.append(f"--top={request.top_k}")
         
         # Run the executable
-        result = subprocess.run(
-            command,
-            capture_output=True,
-            text=True
-        )
+        try:
+            result = subprocess.run(
+                command,
+                capture_output=True,
+                text=True
+            )
+        finally:
+            remove_file(constraints_path)
         
         if result.returncode != 0:
             return JSONResponse(
@@ -270,6 +690,271 @@ async def search_teams_by_category(request: SearchByCategoryRequest):
             content={"error": f"Failed to search teams: {str(e)}"}
         )
 
+@app.post("/rebalance-teams/")
+async def rebalance_teams(request: TeamRebalanceRequest):
+    try:
+        file_path = request.file_path
+        # Check if file exists
+        if not os.path.exists(file_path):
+            raise HTTPException(status_code=400, detail="File not found. Please upload the CSV file again.")
+        
+        # Determine the base directory
+        base_dir = os.getcwd()
+        bin_dir = os.path.join(base_dir, "bin")
+        
+        # Handle case where we're in the API directory locally
+        if os.path.basename(base_dir) == "api":
+            bin_dir = os.path.join(os.path.dirname(base_dir), "bin")
+        
+        # Set up the command
+        cpp_exec_path = os.path.join(bin_dir, "team_maker_api.exe")
+
+        # Write the earlier assignment as "team_number,name" lines, to a file of this request only
+        fd, assignment_path = tempfile.mkstemp(suffix=".txt")
+        with os.fdopen(fd, "w", encoding="utf-8") as f:
+            for team in request.previous_teams:
+                for member in team.members:
+                    f.write(f"{team.team_number},{member}\n")
+        
+        # Prepare command arguments
+        command = [
+            cpp_exec_path,
+            file_path,
+            "rebalance",
+            request.generation_type,
+            assignment_path,
+            ",".join(str(cat.index) for cat in request.categories),
+            ",".join(str(cat.weight) for cat in request.categories)
+        ]
+
+        constraints_path = None
+        try:
+            constraints_path = write_constraints_file(request.constraints)
+            if constraints_path:
+                command.append(f"--constraints={constraints_path}")
+            command.extend(generation_options(request))
+            
+            # Run the executable
+            result = subprocess.run(
+                command,
+                capture_output=True,
+                text=True
+            )
+        finally:
+            remove_file(constraints_path)
+            remove_file(assignment_path)
+        
+        if result.returncode != 0:
+            return JSONResponse(
+                status_code=400,
+                content={"error": f"Error rebalancing teams: {result.stderr}"}
+            )
+        
+        # Parse the output ({"moves": n, "teams": [...]})
+        return json.loads(result.stdout)
+    except Exception as e:
+        return JSONResponse(
+            status_code=500,
+            content={"error": f"Failed to rebalance teams: {str(e)}"}
+        )
+
+@app.post("/query-teams/")
+async def query_teams(request: TeamQueryRequest):
+    try:
+        file_path = request.file_path
+        # Check if file exists
+        if not os.path.exists(file_path):
+            raise HTTPException(status_code=400, detail="File not found. Please upload the CSV file again.")
+        
+        # Determine the base directory
+        base_dir = os.getcwd()
+        bin_dir = os.path.join(base_dir, "bin")
+        
+        # Handle case where we're in the API directory locally
+        if os.path.basename(base_dir) == "api":
+            bin_dir = os.path.join(os.path.dirname(base_dir), "bin")
+        
+        # Set up the command
+        cpp_exec_path = os.path.join(bin_dir, "team_maker_api.exe")
+        
+        # Prepare command arguments
+        command = [
+            cpp_exec_path,
+            file_path,
+            "query",
+            request.generation_type,
+            str(request.num_teams),
+            ",".join(str(cat.index) for cat in request.categories),
+            ",".join(str(cat.weight) for cat in request.categories)
+        ]
+
+        if request.query_type == "top":
+            query_weights = request.query_weights or request.categories
+            command.extend(["top", str(request.k), ",".join(f"{cat.index}:{cat.weight}" for cat in query_weights)])
+        elif request.query_type == "near-mean":
+            if request.category_index is None:
+                raise HTTPException(status_code=400, detail="category_index is required for near-mean queries")
+            command.extend(["near-mean", str(request.category_index), str(request.tolerance)])
+        elif request.query_type == "person":
+            if not request.name:
+                raise HTTPException(status_code=400, detail="name is required for person queries")
+            command.extend(["person", request.name])
+        else:
+            raise HTTPException(status_code=400, detail="query_type must be 'top', 'near-mean' or 'person'")
+
+        constraints_path = write_constraints_file(request.constraints)
+        if constraints_path:
+            command.append(f"--constraints={constraints_path}")
+        command.extend(generation_options(request))
+        
+        # Run the executable
+        try:
+            result = subprocess.run(
+                command,
+                capture_output=True,
+                text=True
+            )
+        finally:
+            remove_file(constraints_path)
+        
+        if result.returncode != 0:
+            return JSONResponse(
+                status_code=400,
+                content={"error": f"Error querying teams: {result.stderr}"}
+            )
+        
+        return json.loads(result.stdout)
+    except HTTPException:
+        raise
+    except Exception as e:
+        return JSONResponse(
+            status_code=500,
+            content={"error": f"Failed to query teams: {str(e)}"}
+        )
+
+@app.post("/sweep-teams/")
+async def sweep_teams(request: TeamSweepRequest):
+    try:
+        file_path = request.file_path
+        # Check if file exists
+        if not os.path.exists(file_path):
+            raise HTTPException(status_code=400, detail="File not found. Please upload the CSV file again.")
+        if not request.weight_vectors:
+            raise HTTPException(status_code=400, detail="weight_vectors must not be empty")
+        
+        # Determine the base directory
+        base_dir = os.getcwd()
+        bin_dir = os.path.join(base_dir, "bin")
+        
+        # Handle case where we're in the API directory locally
+        if os.path.basename(base_dir) == "api":
+            bin_dir = os.path.join(os.path.dirname(base_dir), "bin")
+        
+        # Set up the command
+        cpp_exec_path = os.path.join(bin_dir, "team_maker_api.exe")
+        
+        # The weight matrix goes through a file, one vector per line, to keep the command line short
+        with tempfile.NamedTemporaryFile("w", suffix=".txt", delete=False) as weights_file:
+            for weights in request.weight_vectors:
+                weights_file.write(",".join(str(w) for w in weights) + "\n")
+        
+        command = [
+            cpp_exec_path,
+            file_path,
+            "sweep",
+            str(request.num_teams),
+            ",".join(str(index) for index in request.categories),
+            weights_file.name
+        ]
+        if request.threads is not None:
+            command.append(f"--threads={request.threads}")
+        
+        # Run the executable
+        try:
+            result = subprocess.run(
+                command,
+                capture_output=True,
+                text=True
+            )
+        finally:
+            os.unlink(weights_file.name)
+        
+        if result.returncode != 0:
+            return JSONResponse(
+                status_code=400,
+                content={"error": f"Error sweeping weights: {result.stderr}"}
+            )
+        
+        return json.loads(result.stdout)
+    except HTTPException:
+        raise
+    except Exception as e:
+        return JSONResponse(
+            status_code=500,
+            content={"error": f"Failed to sweep weights: {str(e)}"}
+        )
+
+@app.post("/generate-hierarchy/")
+async def generate_hierarchy(request: TeamHierarchyRequest):
+    try:
+        file_path = request.file_path
+        # Check if file exists
+        if not os.path.exists(file_path):
+            raise HTTPException(status_code=400, detail="File not found. Please upload the CSV file again.")
+        if not request.levels:
+            raise HTTPException(status_code=400, detail="levels must not be empty")
+        
+        # Determine the base directory
+        base_dir = os.getcwd()
+        bin_dir = os.path.join(base_dir, "bin")
+        
+        # Handle case where we're in the API directory locally
+        if os.path.basename(base_dir) == "api":
+            bin_dir = os.path.join(os.path.dirname(base_dir), "bin")
+        
+        # Set up the command
+        cpp_exec_path = os.path.join(bin_dir, "team_maker_api.exe")
+        
+        command = [
+            cpp_exec_path,
+            file_path,
+            "hierarchy",
+            ",".join(str(count) for count in request.levels)
+        ]
+        if request.categories:
+            command.extend([
+                ",".join(str(cat.index) for cat in request.categories),
+                ",".join(str(cat.weight) for cat in request.categories)
+            ])
+        if request.diversity_categories:
+            command.append("--diversity=" + ",".join(str(c) for c in request.diversity_categories))
+        if request.threads is not None:
+            command.append(f"--threads={request.threads}")
+        if request.include_metrics:
+            command.append("--metrics")
+        
+        # Run the executable
+        result = subprocess.run(
+            command,
+            capture_output=True,
+            text=True
+        )
+        
+        if result.returncode != 0:
+            return JSONResponse(
+                status_code=400,
+                content={"error": f"Error generating hierarchy: {result.stderr}"}
+            )
+        
+        return json.loads(result.stdout)
+    except HTTPException:
+        raise
+    except Exception as e:
+        return JSONResponse(
+            status_code=500,
+            content={"error": f"Failed to generate hierarchy: {str(e)}"}
+        )
+
 # Determine the frontend directory based on the environment
 frontend_dir = os.path.join(os.getcwd(), "frontend")
 
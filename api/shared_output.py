@@ -0,0 +1,83 @@
+import mmap
+import os
+import struct
+import subprocess
+import uuid
+from typing import Iterator, List, Optional, Tuple
+
+# Header of a result segment written by team_maker_api.exe --output-shm=<name>
+# (see cpp/include/SharedOutput.h): magic, version, payload offset, payload size and the
+# complete flag, all little-endian
+HEADER = struct.Struct("<4sIQQII")
+MAGIC = b"TMSH"
+VERSION = 1
+
+# POSIX shared-memory objects live here on Linux
+SHM_DIR = "/dev/shm"
+
+# Bytes handed to the response per chunk when streaming a payload
+CHUNK_BYTES = 1 << 20
+
+def shared_memory_available() -> bool:
+    """True if results can be handed over in shared memory instead of a pipe"""
+    return os.path.isdir(SHM_DIR)
+
+def _segment_path(name: str) -> str:
+    return os.path.join(SHM_DIR, name.lstrip("/"))
+
+class SharedOutput:
+    """Read-only mapping of a result segment. The segment is unlinked as soon as it is mapped,
+    so the memory goes away with the mapping and nothing is left behind on errors."""
+
+    def __init__(self, name: str):
+        path = _segment_path(name)
+        try:
+            with open(path, "rb") as f:
+                self._map = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+        finally:
+            if os.path.exists(path):
+                os.unlink(path)
+        magic, version, offset, size, complete, _ = HEADER.unpack_from(self._map, 0)
+        if not complete:
+            # A command that exits early leaves its message in the payload
+            message = self._map[HEADER.size:].decode("utf-8", "replace").strip()
+            self._map.close()
+            raise ValueError(message or "The command did not complete its output")
+        if magic != MAGIC or version > VERSION or offset + size > len(self._map):
+            self._map.close()
+            raise ValueError("Not a supported shared-memory result")
+        self._offset = offset
+        self.size = size
+
+    def payload(self) -> bytes:
+        """The whole payload as bytes"""
+        return self._map[self._offset:self._offset + self.size]
+
+    def chunks(self, prefix: bytes = b"", suffix: bytes = b"") -> Iterator[bytes]:
+        """The payload in slices of CHUNK_BYTES for a StreamingResponse; the mapping is closed
+        once the last slice has been taken"""
+        try:
+            if prefix:
+                yield prefix
+            end = self._offset + self.size
+            for start in range(self._offset, end, CHUNK_BYTES):
+                yield self._map[start:min(start + CHUNK_BYTES, end)]
+            if suffix:
+                yield suffix
+        finally:
+            self.close()
+
+    def close(self):
+        self._map.close()
+
+def run_with_shared_output(command: List[str]) -> Tuple[subprocess.CompletedProcess, Optional[SharedOutput]]:
+    """Run team_maker_api.exe with its stdout going to a fresh shared-memory segment. Returns the
+    process (stdout holds only a summary) and the mapped result, or None if the command failed."""
+    name = "team_maker_" + uuid.uuid4().hex
+    result = subprocess.run(command + [f"--output-shm={name}"], capture_output=True, text=True)
+    if result.returncode != 0:
+        path = _segment_path(name)
+        if os.path.exists(path):
+            os.unlink(path)
+        return result, None
+    return result, SharedOutput(name)
@@ -0,0 +1,50 @@
+#ifndef ANNEALINGOPTIMIZER_H
+#define ANNEALINGOPTIMIZER_H
+
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+using namespace std;
+
+// Class to balance teams on several categories at once with simulated annealing. The cost is
+// the weighted sum over categories of the variance of the team totals, each category scaled
+// by the variance of its scores so that categories on different scales compare. Scores are
+// stored person-major and totals team-major, so the cost change of a swap is computed in
+// O(categories). Persons swapped recently are tabu for a few iterations unless the swap gives
+// a new best. Every thread runs its own chain and threads exchange their best assignment
+// periodically.
+class AnnealingOptimizer
+{
+protected:
+    typedef chrono::steady_clock Clock;
+
+    int numPersons;
+    int numCategories;
+    int numTeams;
+    vector<double> values; // values[person * numCategories + category], scaled
+    vector<int> swapClass; // -1 for Persons that must stay in their team
+    vector<vector<int>> classMembers;
+    vector<int> movable;
+    long iterations = 0;
+    int tenure = 0;
+    const atomic<bool> *stop = nullptr; // stops the run early once set
+
+    mutex bestMutex;
+    vector<int> bestTeamOf;
+    double bestCost;
+
+    double costOf(const vector<int> &teamOf, vector<double> &totals) const;
+    double swapDelta(const vector<double> &totals, int first, int second, int firstTeam, int secondTeam) const;
+    void anneal(unsigned seed, Clock::time_point deadline, bool hasDeadline);
+
+public:
+    AnnealingOptimizer(const vector<const vector<double> *> &columns, const vector<double> &weights,
+                       const vector<int> &swapClass, const vector<int> &teamOf, int numTeams);
+    void setIterations(long iterations);
+    void setStopFlag(const atomic<bool> *stop);
+    const vector<int> &run(double deadlineMs, int threads);
+    double getCost() const;
+};
+
+#endif // ANNEALINGOPTIMIZER_H
\ No newline at end of file
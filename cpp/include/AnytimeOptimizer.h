@@ -0,0 +1,55 @@
+#ifndef ANYTIMEOPTIMIZER_H
+#define ANYTIMEOPTIMIZER_H
+
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <functional>
+using namespace std;
+
+// Class to improve an assignment of Persons to teams until a wall-clock deadline or until no
+// swap helps. Every thread hill-climbs on its own copy of the index-based assignment, swapping
+// two Persons of the same swap class whenever that lowers the sum of squared team totals
+// (the totals' sum is fixed, so this is the variance of the totals). Threads exchange their
+// best assignment through a shared slot, and improvements are reported to a listener at most
+// once per interval.
+class AnytimeOptimizer
+{
+public:
+    typedef function<void(const vector<int> &teamOf, double stddev, double elapsedMs)> Listener;
+
+protected:
+    typedef chrono::steady_clock Clock;
+
+    vector<double> scores;
+    vector<int> swapClass; // -1 for Persons that must stay in their team
+    vector<vector<int>> classMembers;
+    vector<int> movable;
+    int numTeams;
+
+    Listener listener;
+    double intervalMs = 50.0;
+    const atomic<bool> *stop = nullptr; // stops the run early once set
+
+    mutex bestMutex;
+    vector<int> bestTeamOf;
+    double bestCost;
+    Clock::time_point start;
+    Clock::time_point lastReport;
+
+    double costOf(const vector<int> &teamOf, vector<double> &totals) const;
+    double stddevOf(double cost) const;
+    double elapsedMs(Clock::time_point now) const;
+    void report(Clock::time_point now);
+    void refine(unsigned seed, Clock::time_point deadline, bool hasDeadline);
+
+public:
+    AnytimeOptimizer(const vector<double> &scores, const vector<int> &swapClass, const vector<int> &teamOf, int numTeams);
+    void setListener(const Listener &listener, double intervalMs);
+    void setStopFlag(const atomic<bool> *stop);
+    const vector<int> &run(double deadlineMs, int threads);
+    double getStddev() const;
+};
+
+#endif // ANYTIMEOPTIMIZER_H
\ No newline at end of file
@@ -0,0 +1,54 @@
+#ifndef ARROWIPCREADER_H
+#define ARROWIPCREADER_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <map>
+#include "ColumnarInput.h"
+using namespace std;
+
+// Class to read flat tables from an Arrow IPC file (the Feather V2 format). The footer and the
+// message headers are FlatBuffers and are decoded in place; record batch buffers are copied
+// straight into the columns. Supports uncompressed files with integer, floating-point, boolean
+// and (large) UTF-8 string columns, dictionary-encoded or not.
+class ArrowIpcReader
+{
+protected:
+    // Struct to describe one field of the schema
+    struct Field
+    {
+        string name;
+        int type;          // Arrow Type union tag
+        int bitWidth;      // Int: bits; FloatingPoint: 16, 32 or 64
+        bool isSigned;
+        long dictionaryId; // -1 if not dictionary-encoded
+        int indexBitWidth;
+        bool indexSigned;
+    };
+
+    // Struct to locate one message (dictionary or record batch) in the file
+    struct Block
+    {
+        uint64_t offset;
+        uint64_t metaDataLength;
+        uint64_t bodyLength;
+    };
+
+    const string &data;
+    vector<Field> fields;
+    vector<Block> dictionaryBlocks;
+    vector<Block> recordBatchBlocks;
+    map<long, vector<string>> dictionaries;
+
+    void readFooter();
+    void readDictionary(const Block &block);
+    void appendBatch(const Block &block, const vector<int> &selected, vector<RosterColumn> &columns);
+
+public:
+    ArrowIpcReader(const string &data);
+    vector<string> columnNames() const;
+    vector<RosterColumn> readColumns(const vector<int> &columns);
+};
+
+#endif // ARROWIPCREADER_H
\ No newline at end of file
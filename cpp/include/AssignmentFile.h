@@ -0,0 +1,45 @@
+#ifndef ASSIGNMENTFILE_H
+#define ASSIGNMENTFILE_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include "Team.h"
+#include "Roster.h"
+using namespace std;
+
+// Layout of the binary assignment file, little-endian with every section starting at a
+// multiple of 8 bytes so that it can be memory-mapped and read as typed arrays:
+//   header          magic "TMAS", version, persons, teams, categories, section offsets
+//   team_of         int32[persons]       team of every roster row, -1 if unassigned
+//   team_offsets    uint64[teams + 1]    start of every team in members
+//   members         int32[team_offsets[teams]]  roster rows, team by team in listing order
+//   scores          float64[teams]       total weighted score of every team
+//   categories      per category: int32 index, int32 0, float64[teams] team totals
+//   name_offsets    uint64[persons + 1]  start of every name in names, optional
+//   names           UTF-8 bytes of the names in roster order, optional
+// Roster rows are the data lines of the CSV file in order, so without names a reader joins
+// the columns with its copy of the roster; the name offsets are 0 in the header then.
+struct AssignmentFileHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint64_t numPersons;
+    uint32_t numTeams;
+    uint32_t numCategories;
+    uint64_t teamOfOffset;
+    uint64_t teamOffsetsOffset;
+    uint64_t membersOffset;
+    uint64_t scoresOffset;
+    uint64_t categoriesOffset;
+    uint64_t nameOffsetsOffset;
+    uint64_t namesOffset;
+    uint64_t fileSize;
+};
+
+// Write the teams as a binary assignment file. Category totals are written for the numeric
+// categories of roster when it is given; weighted scores and names come from the teams.
+// Returns the size of the file in bytes.
+uint64_t writeAssignmentFile(const string &path, const vector<Team> &teams, const Roster *roster, bool withNames);
+
+#endif // ASSIGNMENTFILE_H
\ No newline at end of file
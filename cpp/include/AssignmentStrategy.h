@@ -0,0 +1,86 @@
+#ifndef ASSIGNMENTSTRATEGY_H
+#define ASSIGNMENTSTRATEGY_H
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <functional>
+#include <atomic>
+#include <map>
+#include "Team.h"
+#include "Roster.h"
+#include "TeamConstraints.h"
+#include "TeamSizeBounds.h"
+using namespace std;
+
+// Struct to describe a strategy: its parameters and what it supports
+struct StrategyInfo
+{
+    string name;
+    string description;
+    bool needsCategories;      // requires category indices and weights
+    bool deterministic;        // same input always gives the same teams
+    bool supportsThreads;      // uses StrategyRequest::threads
+    bool supportsDeadline;     // honours StrategyRequest::deadlineMs
+    vector<string> parameters; // options the strategy reads besides the team count
+};
+
+// Struct to carry every input a strategy may use
+struct StrategyRequest
+{
+    string filename;
+    int numTeams = 0;
+    vector<int> categoryIndices;
+    vector<double> weights;
+    TeamConstraints constraints;
+    TeamSizeBounds bounds;
+    vector<int> diversityColumns;
+    int threads = 1;
+    double deadlineMs = 0.0; // 0 means no deadline
+    long iterations = 0;     // 0 lets the strategy choose
+    double jitter = 0.0;     // random_categorical: sort key noise in score standard deviations
+    unsigned seed = 0;       // random strategies: fixed seed for repeatable teams, 0 for none
+    // Called by anytime strategies with each better assignment: teams, score stddev, elapsed ms
+    function<void(const vector<Team> &, double, double)> onProgress;
+    // If set, strategies that refine or search stop early and return their best teams so far
+    const atomic<bool> *stop = nullptr;
+};
+
+// Interface of a team assignment strategy
+class AssignmentStrategy
+{
+public:
+    virtual ~AssignmentStrategy() {}
+    virtual StrategyInfo info() const = 0;
+    // Generate the teams; if roster is not null, also fill it with the scores the teams refer to
+    virtual vector<Team> generate(const StrategyRequest &request, Roster *roster) = 0;
+};
+
+// Class to look strategies up by name
+class StrategyRegistry
+{
+public:
+    typedef function<unique_ptr<AssignmentStrategy>()> Factory;
+
+protected:
+    vector<pair<StrategyInfo, Factory>> strategies;
+    StrategyRegistry();
+
+public:
+    static StrategyRegistry &instance();
+    void add(Factory factory);
+    unique_ptr<AssignmentStrategy> create(const string &name) const;
+    vector<StrategyInfo> list() const;
+    string names() const;
+};
+
+// Strategy inputs from "--name=value" options (the names without "--"), as given to
+// team_maker_api: --constraints, --min-size, --max-size, --capacities, --diversity, --threads,
+// --deadline-ms, --iterations, --jitter and --seed
+TeamConstraints loadConstraints(const map<string, string> &options);
+TeamSizeBounds loadSizeBounds(const map<string, string> &options);
+vector<int> loadDiversityColumns(const map<string, string> &options);
+StrategyRequest buildStrategyRequest(const string &filename, int num_teams, const vector<int> &categoryIndices,
+                                     const vector<double> &weights, const map<string, string> &options);
+
+#endif // ASSIGNMENTSTRATEGY_H
\ No newline at end of file
@@ -0,0 +1,40 @@
+#ifndef BALANCEMETRICS_H
+#define BALANCEMETRICS_H
+
+#include <vector>
+#include <iostream>
+#include "Roster.h"
+#include "TeamAggregates.h"
+using namespace std;
+
+// Struct to hold how evenly one numeric category is spread over the teams (by team totals)
+struct CategoryBalance
+{
+    int category;
+    double mean;
+    double stddev;
+    double spread; // highest minus lowest team total
+    double gini;
+};
+
+// Class to report the balance quality of a team assignment
+class BalanceMetrics
+{
+protected:
+    const Roster &roster;
+    vector<CategoryBalance> categories;
+    int minSize = 0;
+    int maxSize = 0;
+    double sizeStddev = 0.0;
+
+public:
+    BalanceMetrics(const TeamAggregates &aggregates, const Roster &roster);
+    const vector<CategoryBalance> &getCategories() const;
+    int getSizeImbalance() const;
+    void printJson(ostream &os) const;
+};
+
+// Mean, standard deviation, spread and Gini coefficient of a set of team totals
+CategoryBalance summarizeTotals(int category, const vector<double> &totals);
+
+#endif // BALANCEMETRICS_H
\ No newline at end of file
@@ -0,0 +1,30 @@
+#ifndef CATEGORYHISTOGRAM_H
+#define CATEGORYHISTOGRAM_H
+
+#include <vector>
+#include <cstdint>
+#include "Roster.h"
+using namespace std;
+
+// Class to track how many Persons of each categorical value every team holds. The counts
+// and quotas of one team are contiguous, so a team's histogram is a flat run of integers.
+class CategoryHistogram
+{
+protected:
+    const Roster *roster = nullptr;
+    vector<int> columns;
+    vector<int> slotOffsets;
+    int numSlots = 0;
+    vector<uint32_t> counts;
+    vector<uint32_t> quotas;
+
+public:
+    void init(const Roster &roster, const vector<int> &columns, const vector<int> &teamSizes);
+    bool empty() const;
+    bool withinQuota(int person, int team) const;
+    void add(int person, int team);
+    void remove(int person, int team);
+    uint32_t count(int team, int column, int code) const;
+};
+
+#endif // CATEGORYHISTOGRAM_H
\ No newline at end of file
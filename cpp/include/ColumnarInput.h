@@ -0,0 +1,31 @@
+#ifndef COLUMNARINPUT_H
+#define COLUMNARINPUT_H
+
+#include <vector>
+#include <string>
+using namespace std;
+
+// Struct to hold one column of a roster read from a columnar file. Integer, floating-point
+// and boolean columns are numeric; string columns are text. Nulls read as 0 or "", like
+// empty CSV cells.
+struct RosterColumn
+{
+    string name;
+    bool text = false;
+    vector<double> numbers;
+    vector<string> strings;
+};
+
+// True if the file starts like an Arrow IPC file ("ARROW1") or a Parquet file ("PAR1")
+bool isColumnarFile(const string &filename);
+
+// Names of the columns of an Arrow IPC or Parquet file, from its schema
+vector<string> readColumnarHeaders(const string &filename);
+
+// Read the given columns (all of them if empty) of an Arrow IPC or Parquet file, in file order
+vector<RosterColumn> readColumnarFile(const string &filename, const vector<int> &columns = {});
+
+// Whole contents of a file, throwing if it cannot be read
+string readWholeFile(const string &filename);
+
+#endif // COLUMNARINPUT_H
\ No newline at end of file
@@ -0,0 +1,61 @@
+#ifndef EXACTPARTITIONER_H
+#define EXACTPARTITIONER_H
+
+#include <vector>
+#include <chrono>
+#include <atomic>
+#include <unordered_set>
+#include <string>
+#include <cstdint>
+using namespace std;
+
+// Class to split scores into teams of fixed sizes so that the spread between the highest and
+// the lowest team total is as small as possible. The incumbent starts as the better of the
+// balanced Karmarkar-Karp differencing solution and a capacity-aware greedy one, each improved
+// by swaps between the heaviest and the lightest team; branch-and-bound then assigns scores in descending order, pruning on lower bounds of the final spread,
+// on teams in identical states and on partial states (team totals and sizes) already explored,
+// which are remembered in full so that no unexplored state is ever pruned.
+// The search stops at the time limit with the best assignment found so far.
+class ExactPartitioner
+{
+protected:
+    typedef chrono::steady_clock Clock;
+
+    int numTeams;
+    vector<int> capacities;
+    vector<int> order;           // Persons in descending score order
+    vector<double> sortedScores; // scores in that order
+    vector<double> prefix;       // prefix sums of sortedScores
+    double average;
+    double quantum; // spreads are multiples of this, or 0 if unknown
+
+    vector<int> bestTeamOf; // indexed by position in order
+    double bestSpread;
+    bool optimal = false;
+
+    vector<double> totals;
+    vector<int> counts;
+    vector<int> teamOf;
+    unordered_set<string> explored; // canonical partial states, see stateKey()
+    size_t exploredBytes = 0;
+    Clock::time_point deadline;
+    long nodes = 0;
+    bool timedOut = false;
+    const atomic<bool> *stop = nullptr; // ends the search early once set
+
+    void differencingBound();
+    void greedyBound();
+    void offer(vector<int> assignment);
+    double lowerBound(int next) const;
+    void stateKey(int next, string &key) const;
+    void search(int next);
+
+public:
+    ExactPartitioner(const vector<double> &scores, const vector<int> &capacities);
+    void setStopFlag(const atomic<bool> *stop);
+    vector<int> solve(double limitMs);
+    bool isOptimal() const;
+    double getSpread() const;
+};
+
+#endif // EXACTPARTITIONER_H
\ No newline at end of file
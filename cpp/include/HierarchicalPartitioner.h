@@ -0,0 +1,42 @@
+#ifndef HIERARCHICALPARTITIONER_H
+#define HIERARCHICALPARTITIONER_H
+
+#include <vector>
+#include "TaskScheduler.h"
+using namespace std;
+
+// Struct to hold one group of a hierarchy (a division, a team, a sub-squad...): its Persons as
+// roster rows in descending score order, their total score and its sub-groups
+struct HierarchyNode
+{
+    vector<int> members;
+    double total = 0.0;
+    vector<HierarchyNode> children;
+};
+
+// Class to split Persons into groups, those groups into sub-groups and so on, with one number
+// of groups per parent at every level. Every group is split on its own: the Persons of each
+// swap class are dealt to the sub-groups in a zig-zag pattern and the rest of a round goes to
+// the smallest sub-groups, so sub-group sizes and the count of every swap class differ by at
+// most one, and the sub-group totals are then evened out by swaps within swap classes (see
+// AnytimeOptimizer). Subtrees are independent and are split in parallel as tasks of the
+// TaskScheduler.
+class HierarchicalPartitioner
+{
+protected:
+    vector<double> scores;
+    vector<int> swapClass;
+    vector<int> fanOut;
+    HierarchyNode root;
+
+    void split(HierarchyNode &node, int numGroups, int threads) const;
+    void splitSubtree(HierarchyNode &node, int level, int threads, TaskGroup &group) const;
+
+public:
+    HierarchicalPartitioner(const vector<double> &scores, const vector<int> &swapClass, const vector<int> &fanOut);
+    const HierarchyNode &run(int threads);
+    const HierarchyNode &getRoot() const;
+    static vector<int> levelAssignment(const HierarchyNode &root, int level, int numPersons, int &numGroups);
+};
+
+#endif // HIERARCHICALPARTITIONER_H
\ No newline at end of file
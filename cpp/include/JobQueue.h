@@ -0,0 +1,93 @@
+#ifndef JOBQUEUE_H
+#define JOBQUEUE_H
+
+#include <vector>
+#include <string>
+#include <map>
+#include <set>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <condition_variable>
+#include "AssignmentStrategy.h"
+using namespace std;
+
+enum class JobState
+{
+    Queued,
+    Running,
+    Done,
+    Failed,
+    Cancelled
+};
+
+// Name of a state as shown to clients: "queued", "running", "done", "failed" or "cancelled"
+const char *jobStateName(JobState state);
+
+// Struct to report where a job is
+struct JobStatus
+{
+    long id;
+    JobState state;
+    int priority;
+    int queuePosition;  // jobs to run before this one, while queued
+    long improvements;  // better assignments reported so far by anytime strategies
+    double stddev;      // standard deviation of the team scores of the last one, -1 if none
+    double elapsedMs;   // time spent running
+    string error;       // for failed jobs
+};
+
+// Class to run generation requests in the background. Jobs wait in a bounded queue ordered by
+// priority (higher first, then by submission) and a fixed set of threads runs them with their
+// strategy. Cancelling a queued job drops it; cancelling a running one sets its stop flag
+// (StrategyRequest::stop), so refining strategies return at their next check. Finished jobs
+// are kept until their result is taken, up to a limit after which the oldest are forgotten.
+class JobQueue
+{
+protected:
+    typedef chrono::steady_clock Clock;
+
+    struct Job
+    {
+        long id;
+        int priority;
+        string generationType;
+        StrategyRequest request;
+        JobState state = JobState::Queued;
+        long improvements = 0;
+        double stddev = -1.0;
+        Clock::time_point started;
+        double elapsedMs = 0.0;
+        string error;
+        vector<Team> teams;
+        atomic<bool> stop{false};
+    };
+
+    size_t capacity;
+    size_t keepFinished;
+    map<long, shared_ptr<Job>> jobs;
+    set<pair<int, long>> pending; // (-priority, id) of the queued jobs, in run order
+    vector<long> finished;        // ids of finished jobs, oldest first
+    long nextId = 1;
+    bool stopping = false;
+    mutable mutex queueMutex;
+    condition_variable jobReady;
+    vector<thread> workers;
+
+    void workerLoop();
+    void run(Job &job);
+    void finish(Job &job, JobState state);
+    void fillStatus(const Job &job, JobStatus &status) const;
+
+public:
+    JobQueue(int numWorkers, size_t capacity, size_t keepFinished);
+    ~JobQueue();
+    long submit(const string &generationType, const StrategyRequest &request, int priority = 0);
+    bool status(long id, JobStatus &status) const;
+    bool cancel(long id);
+    bool takeResult(long id, vector<Team> &teams, JobStatus &status);
+};
+
+#endif // JOBQUEUE_H
\ No newline at end of file
@@ -0,0 +1,52 @@
+#ifndef LINEREADER_H
+#define LINEREADER_H
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+using namespace std;
+
+// Class to read the lines of a plain or gzip-compressed text file. Compressed files are
+// inflated on a background thread into a bounded ring of blocks, so decompression overlaps
+// with the parsing done by the caller and the file is never expanded on disk.
+class LineReader
+{
+protected:
+    ifstream file;
+    bool compressed = false;
+
+    // Ring of inflated blocks shared with the decompression thread
+    vector<string> ring;
+    size_t head = 0;  // next block to read
+    size_t count = 0; // blocks filled and not yet read
+    bool finished = false;
+    bool stopping = false;
+    string error;
+    mutex ringMutex;
+    condition_variable blockFilled;
+    condition_variable blockFreed;
+    thread inflater;
+
+    string block; // block being read by the caller
+    size_t pos = 0;
+
+    void inflateFile();
+    bool nextBlock();
+
+public:
+    LineReader(const string &filename);
+    ~LineReader();
+    bool isOpen() const;
+    bool isCompressed() const;
+    bool atEnd();
+    bool getline(string &line);
+    string readAll();
+};
+
+// True if the file starts with the gzip magic bytes
+bool isGzipFile(const string &filename);
+
+#endif // LINEREADER_H
\ No newline at end of file
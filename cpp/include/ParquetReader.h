@@ -0,0 +1,47 @@
+#ifndef PARQUETREADER_H
+#define PARQUETREADER_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include "ColumnarInput.h"
+using namespace std;
+
+// Class to read flat tables from a Parquet file. The footer and page headers are Thrift
+// compact structs decoded by hand; data pages may be PLAIN or dictionary encoded, version 1
+// or 2, uncompressed or compressed with Snappy or gzip. Supports BOOLEAN, INT32, INT64,
+// FLOAT, DOUBLE and BYTE_ARRAY (string) columns that are REQUIRED or OPTIONAL.
+class ParquetReader
+{
+protected:
+    // Struct to describe one leaf column of the schema
+    struct Column
+    {
+        string name;
+        int type;      // Parquet physical type
+        bool optional; // definition levels present
+    };
+
+    // Struct to locate one column chunk of one row group
+    struct Chunk
+    {
+        int codec;
+        int64_t numValues;
+        uint64_t start;
+        uint64_t length;
+    };
+
+    const string &data;
+    vector<Column> schemaColumns;
+    vector<vector<Chunk>> rowGroups;
+
+    void readFooter();
+    void readChunk(const Chunk &chunk, const Column &column, RosterColumn &out);
+
+public:
+    ParquetReader(const string &data);
+    vector<string> columnNames() const;
+    vector<RosterColumn> readColumns(const vector<int> &columns);
+};
+
+#endif // PARQUETREADER_H
\ No newline at end of file
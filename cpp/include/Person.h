@@ -10,11 +10,13 @@ class Person
 protected:
     string name;
     double score;
+    int index; // row of the Person in the roster, -1 if unknown
 
 public:
-    Person(const string &n, double s);
-    string getName() const;
+    Person(const string &n, double s, int i = -1);
+    const string &getName() const;
     double getScore() const;
+    int getIndex() const;
 };
 
 // Function to sort Persons by name
@@ -5,11 +5,22 @@
 #include <random>
 using namespace std;
 
-// Class to create random teams with categories
+// Class to create random teams with categories. Without constraints, bounds or diversity
+// categories, teams are drawn stratified: the score order is cut into tiers of one Person per
+// team and every tier is randomly permuted across the teams.
 class RandomCategoricalTeamGenerator : public TeamGenerator
 {
+protected:
+    mt19937 gen;
+    double jitter = 0.0; // random offset of the sort keys, in standard deviations of the scores
+
+    pair<double, double> teamPriority(int size, double total);
+
 public:
-    vector<Team> createTeams(int numTeams);
+    RandomCategoricalTeamGenerator();
+    vector<Team> createTeams(int numTeams, const TeamSizeBounds &bounds = TeamSizeBounds());
+    void setJitter(double jitter);
+    void setSeed(unsigned seed);
 };
 
 #endif // RANDOMCATEGORICALTEAMGENERATOR_H
\ No newline at end of file
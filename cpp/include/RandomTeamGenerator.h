@@ -3,16 +3,23 @@
 
 #include "Generator.h"
 #include "Team.h"
+#include "TeamSizeBounds.h"
 #include <vector>
 #include <string>
+#include <functional>
 using namespace std;
 
 // Class to create random teams
 class RandomTeamGenerator : public Generator
 {
+protected:
+    unsigned seed = 0; // 0 for a random seed on every call
+
 public:
     void readPersonsFromFile(const string &filename, const vector<int> &categoryIndices = {}, const vector<double> &weights = {});
-    vector<Team> createRandomTeams(int numTeams);
+    void setNumPersons(int numPersons);
+    void setSeed(unsigned seed);
+    vector<Team> createRandomTeams(int numTeams, const TeamSizeBounds &bounds = TeamSizeBounds(), int threads = 1);
 };
 
 #endif // RANDOMTEAMGENERATOR_H
\ No newline at end of file
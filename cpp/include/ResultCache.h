@@ -0,0 +1,61 @@
+#ifndef RESULTCACHE_H
+#define RESULTCACHE_H
+
+#include <vector>
+#include <string>
+#include <map>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include "Team.h"
+#include "AssignmentStrategy.h"
+using namespace std;
+
+// Default byte budget of a cache, in memory and in its directory
+static const size_t RESULT_CACHE_DEFAULT_BYTES = 256 << 20;
+
+// Class to remember the teams of repeatable requests: deterministic strategies, and random ones
+// given a seed. A request's key holds the strategy, a fingerprint (device, inode, size and
+// modification time) of the roster file, the team count, categories and weights, and the
+// parsed values of the options the strategy reads, including the constraints themselves, so
+// a repeated request costs a stat() and one hash lookup. Entries beyond the byte budget are evicted
+// least recently used. With a directory, entries are also written there and read back on a
+// miss, so they survive the process; the directory is kept within the same byte budget by
+// removing the least recently used entry files.
+class ResultCache
+{
+protected:
+    struct Entry
+    {
+        string key;
+        shared_ptr<const vector<Team>> teams;
+        size_t bytes;
+    };
+
+    size_t maxBytes;
+    size_t usedBytes = 0;
+    string directory;
+    list<Entry> entries; // most recently used first
+    unordered_map<string, list<Entry>::iterator> index;
+    long hits = 0;
+    long misses = 0;
+    mutable mutex cacheMutex;
+
+    string pathOf(const string &key) const;
+    bool load(const string &key, vector<Team> &teams) const;
+    void save(const string &key, const vector<Team> &teams) const;
+    void prune() const;
+    void insert(const string &key, shared_ptr<const vector<Team>> teams);
+
+public:
+    ResultCache(size_t maxBytes = RESULT_CACHE_DEFAULT_BYTES, const string &directory = "");
+    static string requestKey(const string &generationType, const StrategyRequest &request, const map<string, string> &options);
+    void configure(size_t maxBytes, const string &directory);
+    shared_ptr<const vector<Team>> lookup(const string &key);
+    void store(const string &key, const vector<Team> &teams);
+    long getHits() const;
+    long getMisses() const;
+};
+
+#endif // RESULTCACHE_H
\ No newline at end of file
@@ -0,0 +1,63 @@
+#ifndef ROSTER_H
+#define ROSTER_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <unordered_map>
+#include "ScoreType.h"
+using namespace std;
+
+// Class to hold the roster in columnar form. Numeric categories keep one score per Person,
+// stored as ScoreTraits<Score>::Stored; categorical (text) categories are dictionary-encoded
+// into small integer codes.
+template <typename Score>
+class BasicRoster
+{
+public:
+    typedef ScoreTraits<Score> Traits;
+    typedef typename Traits::Stored Stored;
+    typedef typename Traits::Total Total;
+
+protected:
+    vector<string> names;
+    vector<string> categoryHeaders;
+    vector<bool> categorical;
+    vector<vector<Stored>> numericColumns;
+    vector<vector<uint16_t>> codeColumns;
+    vector<vector<string>> dictionaries;
+    vector<unordered_map<string, uint16_t>> codeLookup;
+
+public:
+    void reset(const vector<string> &categoryHeaders, const vector<bool> &categorical);
+    void addName(const string &name);
+    void addNumeric(int category, double value);
+    void addCategory(int category, const string &value);
+    void setNames(vector<string> &&columnNames);
+    void setNumeric(int category, vector<double> &&values);
+
+    int size() const;
+    int numCategories() const;
+    const string &getName(int person) const;
+    const string &getHeader(int category) const;
+    bool isCategorical(int category) const;
+    const vector<Stored> &numeric(int category) const;
+    double getNumeric(int category, int person) const;
+    const vector<double> &numericValues(int category, vector<double> &buffer) const;
+    const vector<uint16_t> &codes(int category) const;
+    const vector<string> &dictionary(int category) const;
+};
+
+// Columns stored as doubles are handed over and returned as they are
+template <>
+void BasicRoster<double>::setNumeric(int category, vector<double> &&values);
+template <>
+const vector<double> &BasicRoster<double>::numericValues(int category, vector<double> &buffer) const;
+
+// The roster of the build, with the score type selected in ScoreType.h
+typedef BasicRoster<RosterScore> Roster;
+
+// True if the cell holds a plain decimal number (an empty cell counts as numeric)
+bool isNumericCell(const string &cell);
+
+#endif // ROSTER_H
\ No newline at end of file
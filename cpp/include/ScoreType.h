@@ -0,0 +1,77 @@
+#ifndef SCORETYPE_H
+#define SCORETYPE_H
+
+#include <cstdint>
+#include <cmath>
+#include <string>
+#include <stdexcept>
+using namespace std;
+
+// Scale of fixed-point scores: a score is stored as round(value * SCORE_FIXED_SCALE), so the
+// default keeps two decimals
+#ifndef SCORE_FIXED_SCALE
+#define SCORE_FIXED_SCALE 100
+#endif
+
+// Tag of scaled int32 fixed-point scores
+struct FixedScore
+{
+};
+
+// How scores of type Score are stored in the roster columns (Stored) and summed into team
+// totals (Total). Doubles are stored and summed as they are.
+template <typename Score>
+struct ScoreTraits
+{
+    typedef Score Stored;
+    typedef double Total;
+
+    static Stored encode(double value)
+    {
+        return (Stored)value;
+    }
+    static double decode(Stored value)
+    {
+        return value;
+    }
+    static double decodeTotal(Total total)
+    {
+        return total;
+    }
+};
+
+// Fixed-point scores are summed in int64, so team totals are exact and do not depend on the
+// order in which members are added
+template <>
+struct ScoreTraits<FixedScore>
+{
+    typedef int32_t Stored;
+    typedef int64_t Total;
+
+    static Stored encode(double value)
+    {
+        double scaled = round(value * SCORE_FIXED_SCALE);
+        if (!(scaled >= INT32_MIN && scaled <= INT32_MAX))
+            throw runtime_error("Score " + to_string(value) + " does not fit the fixed-point score range");
+        return (Stored)scaled;
+    }
+    static double decode(Stored value)
+    {
+        return value / (double)SCORE_FIXED_SCALE;
+    }
+    static double decodeTotal(Total total)
+    {
+        return total / (double)SCORE_FIXED_SCALE;
+    }
+};
+
+// Score type of the roster columns, chosen at compile time: -DTEAM_MAKER_SCORE_FIXED stores
+// scaled int32, so that team totals in metrics and rankings are exact; double otherwise.
+// Person scores, weighted scores and the optimizers work in double either way.
+#if defined(TEAM_MAKER_SCORE_FIXED)
+typedef FixedScore RosterScore;
+#else
+typedef double RosterScore;
+#endif
+
+#endif // SCORETYPE_H
\ No newline at end of file
@@ -0,0 +1,48 @@
+#ifndef SHAREDOUTPUT_H
+#define SHAREDOUTPUT_H
+
+#include <streambuf>
+#include <string>
+#include <vector>
+#include <cstdint>
+using namespace std;
+
+// Layout of a shared-memory result segment, a POSIX shared-memory object (/dev/shm/<name> on
+// Linux) that the caller maps instead of reading a pipe:
+//   header   magic "TMSH", version, payload offset, payload size, complete flag
+//   payload  the bytes the command would have printed to stdout, usually JSON
+// The header is written last; complete stays 0 if the command failed or was interrupted.
+struct SharedOutputHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint64_t payloadOffset;
+    uint64_t payloadSize;
+    uint32_t complete;
+    uint32_t reserved;
+};
+
+// Class to write stdout into a shared-memory segment: install it with cout.rdbuf(), then
+// call finish() once the command has succeeded. The segment is removed again if finish() is
+// never called, so a failed command leaves nothing behind.
+class SharedOutput : public streambuf
+{
+protected:
+    string name;
+    int fd = -1;
+    vector<char> buffer;
+    uint64_t written = 0;
+    bool finished = false;
+
+    void flushBuffer();
+    int overflow(int c) override;
+    int sync() override;
+
+public:
+    SharedOutput(const string &name);
+    ~SharedOutput();
+    uint64_t finish();
+    const string &getName() const;
+};
+
+#endif // SHAREDOUTPUT_H
\ No newline at end of file
@@ -0,0 +1,110 @@
+#ifndef TASKSCHEDULER_H
+#define TASKSCHEDULER_H
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <functional>
+#include <exception>
+#include <condition_variable>
+#include <iostream>
+using namespace std;
+
+// Struct to hold the counters of one worker of the scheduler
+struct WorkerStats
+{
+    long tasks;    // tasks run
+    long steals;   // tasks taken from another worker's deque
+    double busyMs; // time spent running tasks
+};
+
+// Class to run tasks on a fixed set of worker threads with work stealing. Every worker owns a
+// deque: tasks it submits go to the back and it takes its own work from the back, while idle
+// workers steal from the front of the others' deques. Each deque has its own lock, so there is
+// no global lock on the hot path. Threads that are not workers submit to a shared injection
+// deque and run the tasks of the TaskGroup they wait on, so the pool has one worker thread
+// less than its size. The scheduler is created on first use with the size given to
+// configure(), or the hardware concurrency.
+class TaskScheduler
+{
+public:
+    typedef function<void()> Task;
+
+protected:
+    typedef chrono::steady_clock Clock;
+
+    struct Worker
+    {
+        mutex lock;
+        deque<Task> tasks;
+        atomic<long> executed{0};
+        atomic<long> stolen{0};
+        atomic<long> busyNs{0};
+    };
+
+    int numThreads;
+    vector<unique_ptr<Worker>> workers; // one per worker thread, then the injection deque
+    vector<thread> threads;
+    atomic<long> queued{0};
+    atomic<int> sleeping{0};
+    atomic<bool> stopping{false};
+    mutex sleepMutex;
+    condition_variable wake;
+    Clock::time_point start;
+
+    static int configuredThreads;
+
+    int currentWorker() const;
+    bool take(int self, Task &task);
+    void execute(int self, Task &task);
+    void workerLoop(int self);
+
+public:
+    explicit TaskScheduler(int numThreads);
+    ~TaskScheduler();
+    static TaskScheduler &instance();
+    static void configure(int numThreads);
+    int size() const;
+    void submit(Task task);
+    void runHere(Task &task);
+    void parallelFor(int begin, int end, const function<void(int)> &body);
+    vector<WorkerStats> stats() const;
+    void printStatsJson(ostream &os) const;
+};
+
+// Class to wait for a set of tasks. The tasks wait in the group's own queue and the scheduler
+// gets one stand-in task per task, which runs the next one still queued. wait() runs the
+// group's queued tasks on the calling thread and otherwise sleeps until the group is done, so
+// a waiter never picks up another group's work. Groups can be nested inside tasks, and wait()
+// rethrows the first exception a task threw.
+class TaskGroup
+{
+protected:
+    // Shared with the stand-in tasks, which may outlive the group once its queue is empty
+    struct State
+    {
+        mutex lock;
+        condition_variable changed; // a task was queued or the last one finished
+        deque<TaskScheduler::Task> pending;
+        int remaining = 0;
+        exception_ptr error;
+    };
+
+    TaskScheduler &scheduler;
+    shared_ptr<State> state;
+
+    static bool runNext(State &state, TaskScheduler *scheduler);
+    void finish();
+
+public:
+    explicit TaskGroup(TaskScheduler &scheduler = TaskScheduler::instance());
+    ~TaskGroup();
+    void run(const TaskScheduler::Task &task);
+    void wait();
+};
+
+#endif // TASKSCHEDULER_H
\ No newline at end of file
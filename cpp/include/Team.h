@@ -13,8 +13,10 @@ protected:
     vector<Person> members;
 
 public:
-    vector<Person> getmembers() const; // Added const here
+    const vector<Person> &getmembers() const; // Added const here
     void addPerson(const Person &Person);
+    void addPerson(Person &&Person);
+    void reserve(int size);
     void printTeamWithWeights() const;
     void printTeamWithoutWeights() const;
     void printTeamWithoutWeights(ostream &os) const;
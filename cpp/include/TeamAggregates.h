@@ -0,0 +1,30 @@
+#ifndef TEAMAGGREGATES_H
+#define TEAMAGGREGATES_H
+
+#include <vector>
+#include "Team.h"
+#include "Roster.h"
+using namespace std;
+
+// Class to hold per-team aggregates in columnar form: the team of every roster row, the team
+// sizes and, for every numeric category, one contiguous column of team totals
+class TeamAggregates
+{
+protected:
+    vector<int> teamOfPerson;
+    vector<int> sizes;
+    vector<vector<double>> totals;
+
+    void accumulateTotals(const Roster &roster);
+
+public:
+    TeamAggregates(const vector<Team> &teams, const Roster &roster);
+    TeamAggregates(const vector<int> &teamOfPerson, int numTeams, const Roster &roster);
+    int getNumTeams() const;
+    int teamOf(int person) const;
+    const vector<int> &getTeamOfPerson() const;
+    const vector<int> &getSizes() const;
+    const vector<double> &getTotals(int category) const;
+};
+
+#endif // TEAMAGGREGATES_H
\ No newline at end of file
@@ -0,0 +1,64 @@
+#ifndef TEAMCONSTRAINTS_H
+#define TEAMCONSTRAINTS_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include "Person.h"
+using namespace std;
+
+// Class to represent keep-together and keep-apart constraints between Persons.
+// Keep-together groups are merged with union-find, so every group is placed as one unit.
+// Keep-apart pairs are stored as a bitset adjacency between the groups involved, plus a
+// per-team counter of blocking neighbours so that feasibility checks are O(1).
+class TeamConstraints
+{
+protected:
+    vector<vector<string>> togetherNames;
+    vector<pair<string, string>> apartNames;
+
+    // Union-find over Person indices, flattened into group ids by bind()
+    vector<int> parent;
+    vector<int> group;
+    vector<int> groupOffsets;
+    vector<int> groupPersons;
+
+    // Keep-apart adjacency over the groups that appear in at least one keep-apart pair
+    vector<int> apartId;
+    vector<int> apartGroup; // group of every keep-apart id
+    vector<vector<int>> apartNeighbours;
+    vector<uint64_t> apartBits;
+    int apartWords = 0;
+
+    // blocked[apartId * numTeams + team] = keep-apart neighbours of that group placed in team
+    vector<int> blocked;
+    int numTeams = 0;
+
+    int findRoot(int person);
+    void checkApartCliques() const;
+
+public:
+    void readFromFile(const string &filename);
+    void addTogether(const vector<string> &names);
+    void addApart(const string &first, const string &second);
+    bool empty() const;
+    string canonical() const;
+
+    void bind(const vector<Person> &persons, int numTeams);
+    void clearPlacements();
+
+    int numGroups() const;
+    int groupOf(int person) const;
+    int groupSize(int groupIndex) const;
+    const int *groupMembers(int groupIndex) const;
+
+    bool isFixed(int person) const;
+    int apartDegree(int groupIndex) const;
+    vector<int> apartNeighboursOf(int groupIndex) const;
+    bool canPlace(int groupIndex, int team) const;
+    bool conflicts(int firstGroup, int secondGroup) const;
+    void place(int groupIndex, int team);
+    void remove(int groupIndex, int team);
+};
+
+#endif // TEAMCONSTRAINTS_H
\ No newline at end of file
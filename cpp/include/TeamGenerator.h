@@ -3,8 +3,15 @@
 
 #include "Generator.h"
 #include "Team.h"
+#include "TeamConstraints.h"
+#include "TeamSizeBounds.h"
+#include "Roster.h"
+#include "CategoryHistogram.h"
+#include "HierarchicalPartitioner.h"
 #include <vector>
 #include <string>
+#include <functional>
+#include <atomic>
 using namespace std;
 
 // Class to create balanced teams
@@ -14,14 +21,45 @@ protected:
     vector<Team> teams;
     vector<string> headers;
     vector<int> categoryIndices;
+    vector<double> weights;
+    TeamConstraints constraints;
+    TeamSizeBounds sizeBounds;
+    Roster roster;
+    vector<int> diversityColumns;
+    CategoryHistogram histogram;
+    int lastMoveCount = 0;
+    const atomic<bool> *stopFlag = nullptr;
+
+    vector<int> sortGroupsByScore(vector<double> &groupScores) const;
+    virtual pair<double, double> teamPriority(int size, double total);
+    bool groupWithinQuota(int group, int team) const;
+    void placeGroups(int numTeams, vector<int> &teamOf, const vector<int> &order, const vector<double> &groupScores);
+    int repairTeamSizes(int numTeams, vector<int> &teamOf, bool balanceSizes);
+    vector<Team> collectTeams(int numTeams, const vector<int> &teamOf, const vector<int> &order);
+    vector<Team> assignGroups(int numTeams);
+    vector<int> currentAssignment() const;
+    vector<int> swapClasses() const;
+    vector<Team> teamsFromAssignment(int numTeams, const vector<int> &teamOf) const;
+    void readPersonsFromColumns(const string &filename, const vector<bool> &selected, const vector<double> &weightOf);
 
 public:
     vector<string> getheaders();
     void readPersonsFromFile(const string &filename, const vector<int> &categoryIndices, const vector<double> &weights);
-    vector<Team> createTeams(int numTeams);
+    void setScores(const vector<double> &scores);
+    const Roster &getRoster() const;
+    void setDiversityColumns(const vector<int> &columns);
+    void setConstraints(const TeamConstraints &constraints);
+    void setStopFlag(const atomic<bool> *stop);
+    virtual vector<Team> createTeams(int numTeams, const TeamSizeBounds &bounds = TeamSizeBounds());
+    vector<Team> refineTeams(double deadlineMs, int threads, const function<void(const vector<Team> &, double, double)> &onImprove = nullptr);
+    vector<Team> partitionTeams(int numTeams, const TeamSizeBounds &bounds, double limitMs);
+    vector<Team> annealTeams(long iterations, double deadlineMs, int threads);
+    HierarchyNode createHierarchy(const vector<int> &fanOut, int threads);
+    vector<Team> rebalanceTeams(const vector<vector<string>> &previousTeams, const TeamSizeBounds &bounds = TeamSizeBounds());
+    int getLastMoveCount() const;
     void printTeamsWithWeights(const vector<Team> &teams);
     void printTeamsWithoutWeights(const vector<Team> &teams);
-    void searchTeamsByCategory(int categoryIndex, const string &filename);
+    void searchTeamsByCategory(int categoryIndex, int topK = 0);
     void displayCategories();
 };
 
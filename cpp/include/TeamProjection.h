@@ -0,0 +1,34 @@
+#ifndef TEAMPROJECTION_H
+#define TEAMPROJECTION_H
+
+#include <vector>
+#include <string>
+#include <map>
+#include <iostream>
+#include "Team.h"
+using namespace std;
+
+// Struct to select the part of an assignment a client is shown: which fields of every team,
+// which range of teams, and how many members of each. Only the emitted teams are visited, and
+// member names are only read for the members that are printed, so the cost of an answer
+// follows its size rather than the roster's.
+struct TeamProjection
+{
+    bool members = true;
+    bool size = false;
+    bool score = false; // total score of the members
+    int teamOffset = 0;
+    int teamLimit = -1;   // -1 means all teams from teamOffset
+    int memberLimit = -1; // -1 means all members
+
+    bool isSet() const;
+    int firstTeam(int numTeams) const;
+    int endTeam(int numTeams) const;
+    void printJson(ostream &os, const vector<Team> &teams) const;
+};
+
+// Read the --fields=members,size,score, --team-offset, --team-limit and --member-limit options.
+// Throws invalid_argument for an unknown field or a negative number.
+TeamProjection loadTeamProjection(const map<string, string> &options);
+
+#endif // TEAMPROJECTION_H
\ No newline at end of file
@@ -0,0 +1,28 @@
+#ifndef TEAMQUERY_H
+#define TEAMQUERY_H
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include "Roster.h"
+#include "TeamAggregates.h"
+using namespace std;
+
+// Class to answer analyst queries over generated teams from the columnar team aggregates
+class TeamQuery
+{
+protected:
+    const TeamAggregates &aggregates;
+    const Roster &roster;
+    unordered_map<string, int> personIndex;
+
+    void checkNumeric(int category) const;
+
+public:
+    TeamQuery(const TeamAggregates &aggregates, const Roster &roster);
+    vector<pair<int, double>> topWeighted(const vector<pair<int, double>> &weights, int k) const;
+    vector<pair<int, double>> nearMean(int category, double tolerance) const;
+    int teamOfPerson(const string &name) const;
+};
+
+#endif // TEAMQUERY_H
\ No newline at end of file
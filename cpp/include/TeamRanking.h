@@ -0,0 +1,36 @@
+#ifndef TEAMRANKING_H
+#define TEAMRANKING_H
+
+#include <vector>
+#include <iostream>
+#include "Team.h"
+#include "Roster.h"
+using namespace std;
+
+// Struct to hold the statistics of one team in one category
+struct TeamRank
+{
+    int team;
+    double total;
+    int size;
+    double variance;
+};
+
+// Class to rank teams by their total in one numeric category. Totals are computed once from
+// the roster columns; ties are broken by team size (larger first), then by the variance of
+// the members' scores (smaller first) and finally by team number.
+class TeamRanking
+{
+protected:
+    vector<TeamRank> stats;
+
+public:
+    TeamRanking(const vector<Team> &teams, const Roster &roster, int category);
+    const vector<TeamRank> &getStats() const;
+    vector<TeamRank> top(int k = 0) const;
+};
+
+// Print the teams ranked by their total in one of the categories used to create them
+void printTeamRanking(const vector<Team> &teams, const Roster &roster, const vector<int> &categoryIndices, int categoryIndex, int topK = 0);
+
+#endif // TEAMRANKING_H
\ No newline at end of file
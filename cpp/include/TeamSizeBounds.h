@@ -0,0 +1,21 @@
+#ifndef TEAMSIZEBOUNDS_H
+#define TEAMSIZEBOUNDS_H
+
+#include <vector>
+using namespace std;
+
+// Struct to represent the allowed team sizes: shared min/max sizes or exact per-team capacities
+struct TeamSizeBounds
+{
+    int minSize = 0;
+    int maxSize = 0;        // 0 means no upper bound
+    vector<int> capacities; // exact size of every team, overrides minSize and maxSize
+
+    bool isSet() const;
+    int minFor(int team) const;
+    int maxFor(int team) const;
+    void validate(int numTeams, int numPersons) const;
+    vector<int> targetSizes(int numTeams, int numPersons) const;
+};
+
+#endif // TEAMSIZEBOUNDS_H
\ No newline at end of file
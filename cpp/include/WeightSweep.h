@@ -0,0 +1,33 @@
+#ifndef WEIGHTSWEEP_H
+#define WEIGHTSWEEP_H
+
+#include <vector>
+#include <memory>
+#include <iostream>
+#include "Roster.h"
+#include "BalanceMetrics.h"
+using namespace std;
+
+// Class to evaluate many weight vectors over one roster. The weighted scores of a block of
+// scenarios are computed together by a blocked kernel over the category columns (a matrix
+// product of the roster columns and the weight vectors), every scenario is then split into
+// teams with the snake draft of TeamGenerator::createTeams, and its balance metrics are kept.
+// Blocks of scenarios run in parallel on the TaskScheduler.
+class WeightSweep
+{
+protected:
+    const Roster &roster;
+    vector<int> categoryIndices;
+    vector<vector<double>> weightVectors;
+    vector<unique_ptr<BalanceMetrics>> results;
+
+    void computeScores(int first, int last, vector<double> &scores) const;
+    void snakeDraft(const double *scores, int numTeams, vector<int> &order, vector<int> &teamOf) const;
+
+public:
+    WeightSweep(const Roster &roster, const vector<int> &categoryIndices, const vector<vector<double>> &weightVectors);
+    void run(int numTeams);
+    void printJson(ostream &os) const;
+};
+
+#endif // WEIGHTSWEEP_H
\ No newline at end of file
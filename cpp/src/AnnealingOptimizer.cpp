@@ -0,0 +1,256 @@
+#include "../include/AnnealingOptimizer.h"
+#include "../include/TaskScheduler.h"
+#include <cmath>
+#include <random>
+#include <algorithm>
+using namespace std;
+
+// Iterations between clock checks and between exchanges of the best assignment, swaps sampled
+// to choose the starting temperature, and the ratio of the final to the starting temperature
+static const int CHECK_EVERY = 256;
+static const long EXCHANGE_EVERY = 1 << 16;
+static const int TEMPERATURE_SAMPLES = 1000;
+static const double FINAL_TEMPERATURE_RATIO = 1e-4;
+
+// Default iterations per thread: ITERATIONS_PER_PERSON per movable Person, but at least
+// MIN_ITERATIONS so that small rosters still cool slowly enough
+static const long ITERATIONS_PER_PERSON = 30;
+static const long MIN_ITERATIONS = 200000;
+
+AnnealingOptimizer::AnnealingOptimizer(const vector<const vector<double> *> &columns, const vector<double> &weights,
+                                       const vector<int> &swapClass, const vector<int> &teamOf, int numTeams)
+    : numPersons(teamOf.size()), numCategories(columns.size()), numTeams(numTeams), swapClass(swapClass), bestTeamOf(teamOf)
+{
+    // Scale every category by sqrt(weight / variance), so squared totals carry weight / variance
+    values.assign((size_t)numPersons * numCategories, 0.0);
+    for (int category = 0; category < numCategories; ++category)
+    {
+        const vector<double> &column = *columns[category];
+        double mean = 0.0;
+        for (double value : column)
+            mean += value;
+        mean /= max(1, numPersons);
+        double variance = 0.0;
+        for (double value : column)
+            variance += (value - mean) * (value - mean);
+        variance /= max(1, numPersons);
+        if (variance <= 0 || weights[category] <= 0)
+            continue;
+
+        double scale = sqrt(weights[category] / variance);
+        for (int person = 0; person < numPersons; ++person)
+        {
+            values[(size_t)person * numCategories + category] = column[person] * scale;
+        }
+    }
+
+    for (int person = 0; person < numPersons; ++person)
+    {
+        int cls = swapClass[person];
+        if (cls == -1)
+            continue;
+        if (cls >= classMembers.size())
+            classMembers.resize(cls + 1);
+        classMembers[cls].push_back(person);
+        movable.push_back(person);
+    }
+    iterations = max(MIN_ITERATIONS, ITERATIONS_PER_PERSON * (long)movable.size());
+    tenure = max(2, min(50, (int)movable.size() / 10));
+
+    vector<double> totals;
+    bestCost = costOf(bestTeamOf, totals);
+}
+
+void AnnealingOptimizer::setIterations(long iterations)
+{
+    if (iterations > 0)
+        this->iterations = iterations;
+}
+
+// Sum over teams and categories of the squared scaled totals; also fills the totals
+double AnnealingOptimizer::costOf(const vector<int> &teamOf, vector<double> &totals) const
+{
+    totals.assign((size_t)numTeams * numCategories, 0.0);
+    for (int person = 0; person < numPersons; ++person)
+    {
+        const double *value = &values[(size_t)person * numCategories];
+        double *total = &totals[(size_t)teamOf[person] * numCategories];
+        for (int category = 0; category < numCategories; ++category)
+            total[category] += value[category];
+    }
+    double cost = 0.0;
+    for (double total : totals)
+        cost += total * total;
+    return cost;
+}
+
+// Cost change of exchanging first (in firstTeam) with second (in secondTeam)
+double AnnealingOptimizer::swapDelta(const vector<double> &totals, int first, int second, int firstTeam, int secondTeam) const
+{
+    const double *firstValue = &values[(size_t)first * numCategories];
+    const double *secondValue = &values[(size_t)second * numCategories];
+    const double *firstTotal = &totals[(size_t)firstTeam * numCategories];
+    const double *secondTotal = &totals[(size_t)secondTeam * numCategories];
+    double delta = 0.0;
+    for (int category = 0; category < numCategories; ++category)
+    {
+        double diff = secondValue[category] - firstValue[category];
+        delta += 2.0 * diff * (firstTotal[category] - secondTotal[category] + diff);
+    }
+    return delta;
+}
+
+void AnnealingOptimizer::anneal(unsigned seed, Clock::time_point deadline, bool hasDeadline)
+{
+    vector<int> teamOf;
+    {
+        lock_guard<mutex> lock(bestMutex);
+        teamOf = bestTeamOf;
+    }
+    vector<double> totals;
+    double cost = costOf(teamOf, totals);
+    // The best assignment is snapshotted at every exchange, as copying it on every new best
+    // would dominate the run time; bestSeenCost tracks the best cost for the tabu aspiration
+    vector<int> localBest = teamOf;
+    double localBestCost = cost;
+    double bestSeenCost = cost;
+
+    mt19937 gen(seed);
+    uniform_int_distribution<int> pickMovable(0, movable.size() - 1);
+    uniform_real_distribution<double> unit(0.0, 1.0);
+    auto pickPair = [&](int &first, int &second)
+    {
+        first = movable[pickMovable(gen)];
+        const vector<int> &members = classMembers[swapClass[first]];
+        second = members[uniform_int_distribution<int>(0, members.size() - 1)(gen)];
+    };
+
+    // Start hot enough to accept an average worsening swap half of the time
+    double worsening = 0.0;
+    int worseningCount = 0;
+    for (int sample = 0; sample < TEMPERATURE_SAMPLES; ++sample)
+    {
+        int first, second;
+        pickPair(first, second);
+        if (teamOf[first] == teamOf[second])
+            continue;
+        double delta = swapDelta(totals, first, second, teamOf[first], teamOf[second]);
+        if (delta > 0)
+        {
+            worsening += delta;
+            ++worseningCount;
+        }
+    }
+    if (worseningCount == 0)
+        return;
+    double temperature = worsening / worseningCount / log(2.0);
+    double cooling = pow(FINAL_TEMPERATURE_RATIO, 1.0 / iterations);
+
+    vector<long> lastMoved(numPersons, -tenure);
+    for (long iteration = 1; iteration <= iterations; ++iteration, temperature *= cooling)
+    {
+        int first, second;
+        pickPair(first, second);
+        int firstTeam = teamOf[first];
+        int secondTeam = teamOf[second];
+        if (firstTeam != secondTeam)
+        {
+            double delta = swapDelta(totals, first, second, firstTeam, secondTeam);
+            bool tabu = iteration - lastMoved[first] < tenure || iteration - lastMoved[second] < tenure;
+            bool aspiration = cost + delta < bestSeenCost - 1e-12;
+            bool accept = delta <= 0 || unit(gen) < exp(-delta / temperature);
+            if (accept && (!tabu || aspiration))
+            {
+                double *firstTotal = &totals[(size_t)firstTeam * numCategories];
+                double *secondTotal = &totals[(size_t)secondTeam * numCategories];
+                const double *firstValue = &values[(size_t)first * numCategories];
+                const double *secondValue = &values[(size_t)second * numCategories];
+                for (int category = 0; category < numCategories; ++category)
+                {
+                    double diff = secondValue[category] - firstValue[category];
+                    firstTotal[category] += diff;
+                    secondTotal[category] -= diff;
+                }
+                teamOf[first] = secondTeam;
+                teamOf[second] = firstTeam;
+                lastMoved[first] = lastMoved[second] = iteration;
+                cost += delta;
+                bestSeenCost = min(bestSeenCost, cost);
+            }
+        }
+
+        if (iteration % CHECK_EVERY == 0 && ((hasDeadline && Clock::now() >= deadline) || (stop && stop->load(memory_order_relaxed))))
+            break;
+        if (iteration % EXCHANGE_EVERY != 0)
+            continue;
+
+        // Snapshot the chain (recomputing the totals to drop rounding drift), then publish a
+        // better local best or continue from a better shared one
+        cost = costOf(teamOf, totals);
+        if (cost < localBestCost)
+        {
+            localBest = teamOf;
+            localBestCost = cost;
+        }
+        lock_guard<mutex> lock(bestMutex);
+        if (localBestCost < bestCost)
+        {
+            bestTeamOf = localBest;
+            bestCost = localBestCost;
+        }
+        else if (bestCost < localBestCost)
+        {
+            teamOf = localBest = bestTeamOf;
+            cost = localBestCost = bestSeenCost = costOf(teamOf, totals);
+        }
+    }
+
+    cost = costOf(teamOf, totals);
+    if (cost < localBestCost)
+    {
+        localBest = teamOf;
+        localBestCost = cost;
+    }
+    lock_guard<mutex> lock(bestMutex);
+    if (localBestCost < bestCost)
+    {
+        bestTeamOf = localBest;
+        bestCost = localBestCost;
+    }
+}
+
+// Stop the run as soon as *stop is set, keeping the best assignment found so far
+void AnnealingOptimizer::setStopFlag(const atomic<bool> *stop)
+{
+    this->stop = stop;
+}
+
+// Anneal from the initial assignment on the given number of threads, stopping after the
+// iteration budget or after deadlineMs milliseconds (0 for no deadline)
+const vector<int> &AnnealingOptimizer::run(double deadlineMs, int threads)
+{
+    if (movable.size() < 2 || numCategories == 0)
+        return bestTeamOf;
+
+    bool hasDeadline = deadlineMs > 0;
+    Clock::time_point deadline = Clock::now() + chrono::duration_cast<Clock::duration>(chrono::duration<double, milli>(deadlineMs));
+    // One chain per thread, but no more chains than the scheduler runs side by side
+    TaskScheduler &scheduler = TaskScheduler::instance();
+    int chains = max(1, min(threads, scheduler.size()));
+    random_device rd;
+    TaskGroup group(scheduler);
+    for (int i = 1; i < chains; ++i)
+    {
+        unsigned seed = rd();
+        group.run([this, seed, deadline, hasDeadline]()
+                  { anneal(seed, deadline, hasDeadline); });
+    }
+    anneal(rd(), deadline, hasDeadline);
+    group.wait();
+    return bestTeamOf;
+}
+
+double AnnealingOptimizer::getCost() const
+{
+    return bestCost;
+}
\ No newline at end of file
@@ -0,0 +1,196 @@
+#include "../include/AnytimeOptimizer.h"
+#include "../include/TaskScheduler.h"
+#include <cmath>
+#include <random>
+#include <algorithm>
+using namespace std;
+
+// Swap attempts between clock checks, minimum and per-Person rejected attempts before a thread
+// considers itself converged, and how often threads exchange their best assignment
+static const int CHECK_EVERY = 256;
+static const long STALL_MIN = 10000;
+static const long STALL_PER_PERSON = 20;
+static const double SHARE_MS = 5.0;
+
+AnytimeOptimizer::AnytimeOptimizer(const vector<double> &scores, const vector<int> &swapClass, const vector<int> &teamOf, int numTeams)
+    : scores(scores), swapClass(swapClass), numTeams(numTeams), bestTeamOf(teamOf)
+{
+    for (int person = 0; person < swapClass.size(); ++person)
+    {
+        int cls = swapClass[person];
+        if (cls == -1)
+            continue;
+        if (cls >= classMembers.size())
+            classMembers.resize(cls + 1);
+        classMembers[cls].push_back(person);
+        movable.push_back(person);
+    }
+    vector<double> totals;
+    bestCost = costOf(bestTeamOf, totals);
+}
+
+void AnytimeOptimizer::setListener(const Listener &listener, double intervalMs)
+{
+    this->listener = listener;
+    this->intervalMs = intervalMs;
+}
+
+// Sum of squared team totals; also fills the totals
+double AnytimeOptimizer::costOf(const vector<int> &teamOf, vector<double> &totals) const
+{
+    totals.assign(numTeams, 0.0);
+    for (int person = 0; person < teamOf.size(); ++person)
+    {
+        totals[teamOf[person]] += scores[person];
+    }
+    double cost = 0.0;
+    for (double total : totals)
+    {
+        cost += total * total;
+    }
+    return cost;
+}
+
+// Standard deviation of the team totals, from the sum of their squares
+double AnytimeOptimizer::stddevOf(double cost) const
+{
+    double sum = 0.0;
+    for (double score : scores)
+    {
+        sum += score;
+    }
+    double mean = sum / numTeams;
+    return sqrt(max(0.0, cost / numTeams - mean * mean));
+}
+
+double AnytimeOptimizer::elapsedMs(Clock::time_point now) const
+{
+    return chrono::duration<double, milli>(now - start).count();
+}
+
+// Pass the best assignment to the listener if the interval has passed; bestMutex must be held
+void AnytimeOptimizer::report(Clock::time_point now)
+{
+    if (!listener || chrono::duration<double, milli>(now - lastReport).count() < intervalMs)
+        return;
+    lastReport = now;
+    listener(bestTeamOf, stddevOf(bestCost), elapsedMs(now));
+}
+
+void AnytimeOptimizer::refine(unsigned seed, Clock::time_point deadline, bool hasDeadline)
+{
+    vector<int> teamOf;
+    vector<double> totals;
+    double cost;
+    {
+        lock_guard<mutex> lock(bestMutex);
+        teamOf = bestTeamOf;
+    }
+    cost = costOf(teamOf, totals);
+
+    mt19937 gen(seed);
+    uniform_int_distribution<int> pickMovable(0, movable.size() - 1);
+    long stallLimit = max(STALL_MIN, STALL_PER_PERSON * (long)movable.size());
+    long stall = 0;
+    bool improved = false;
+    Clock::time_point lastShare = Clock::now();
+
+    for (long attempt = 1; stall < stallLimit; ++attempt)
+    {
+        int first = movable[pickMovable(gen)];
+        const vector<int> &members = classMembers[swapClass[first]];
+        int second = members[uniform_int_distribution<int>(0, members.size() - 1)(gen)];
+        int firstTeam = teamOf[first];
+        int secondTeam = teamOf[second];
+
+        // Moving first to secondTeam and second to firstTeam shifts diff from secondTeam to firstTeam
+        double diff = scores[second] - scores[first];
+        double delta = 2.0 * diff * (totals[firstTeam] - totals[secondTeam] + diff);
+        if (firstTeam != secondTeam && delta < -1e-9)
+        {
+            teamOf[first] = secondTeam;
+            teamOf[second] = firstTeam;
+            totals[firstTeam] += diff;
+            totals[secondTeam] -= diff;
+            cost += delta;
+            improved = true;
+            stall = 0;
+        }
+        else
+        {
+            ++stall;
+        }
+
+        if (attempt % CHECK_EVERY != 0)
+            continue;
+        Clock::time_point now = Clock::now();
+        if ((hasDeadline && now >= deadline) || (stop && stop->load(memory_order_relaxed)))
+            break;
+        if (chrono::duration<double, milli>(now - lastShare).count() < SHARE_MS)
+            continue;
+
+        // Publish a better local assignment, or continue from a better shared one
+        lastShare = now;
+        lock_guard<mutex> lock(bestMutex);
+        if (improved && cost < bestCost)
+        {
+            bestTeamOf = teamOf;
+            bestCost = cost;
+            report(now);
+        }
+        else if (bestCost < cost)
+        {
+            teamOf = bestTeamOf;
+            cost = costOf(teamOf, totals);
+            stall = 0;
+        }
+        improved = false;
+    }
+
+    lock_guard<mutex> lock(bestMutex);
+    if (cost < bestCost)
+    {
+        bestTeamOf = teamOf;
+        bestCost = cost;
+    }
+}
+
+// Stop the run as soon as *stop is set, keeping the best assignment found so far
+void AnytimeOptimizer::setStopFlag(const atomic<bool> *stop)
+{
+    this->stop = stop;
+}
+
+// Refine from the initial assignment for up to deadlineMs milliseconds (0 for no deadline) on
+// the given number of threads. The listener first receives the initial assignment.
+const vector<int> &AnytimeOptimizer::run(double deadlineMs, int threads)
+{
+    start = Clock::now();
+    lastReport = start;
+    if (listener)
+        listener(bestTeamOf, stddevOf(bestCost), 0.0);
+    if (movable.empty())
+        return bestTeamOf;
+
+    bool hasDeadline = deadlineMs > 0;
+    Clock::time_point deadline = start + chrono::duration_cast<Clock::duration>(chrono::duration<double, milli>(deadlineMs));
+    // One chain per thread, but no more chains than the scheduler runs side by side
+    TaskScheduler &scheduler = TaskScheduler::instance();
+    int chains = max(1, min(threads, scheduler.size()));
+    random_device rd;
+    TaskGroup group(scheduler);
+    for (int i = 1; i < chains; ++i)
+    {
+        unsigned seed = rd();
+        group.run([this, seed, deadline, hasDeadline]()
+                  { refine(seed, deadline, hasDeadline); });
+    }
+    refine(rd(), deadline, hasDeadline);
+    group.wait();
+    return bestTeamOf;
+}
+
+double AnytimeOptimizer::getStddev() const
+{
+    return stddevOf(bestCost);
+}
\ No newline at end of file
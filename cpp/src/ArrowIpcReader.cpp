@@ -0,0 +1,420 @@
+#include "../include/ArrowIpcReader.h"
+#include <cstring>
+#include <stdexcept>
+using namespace std;
+
+// Arrow Type union tags and MessageHeader union tags used by this reader (see Schema.fbs and
+// Message.fbs in the Arrow format specification)
+static const int TYPE_INT = 2;
+static const int TYPE_FLOATING_POINT = 3;
+static const int TYPE_UTF8 = 5;
+static const int TYPE_BOOL = 6;
+static const int TYPE_LARGE_UTF8 = 20;
+static const int HEADER_DICTIONARY_BATCH = 2;
+static const int HEADER_RECORD_BATCH = 3;
+
+// Magic bytes at both ends of an Arrow IPC file, and the marker before message metadata
+static const char ARROW_MAGIC[] = "ARROW1";
+static const uint32_t CONTINUATION_MARKER = 0xFFFFFFFF;
+
+// Read a little-endian value at pos, checking that it lies inside the data
+template <typename T>
+static T readAt(const string &data, uint64_t pos)
+{
+    if (data.size() < sizeof(T) || pos > data.size() - sizeof(T))
+        throw runtime_error("Corrupt Arrow file: offset out of range");
+    T value;
+    memcpy(&value, data.data() + pos, sizeof(T));
+    return value;
+}
+
+// Struct to read one FlatBuffers table in place
+struct FlatTable
+{
+    const string *data;
+    uint64_t pos;
+
+    // Offset of field id from the table start, or 0 if the field is absent
+    uint16_t fieldOffset(int id) const
+    {
+        uint64_t vtable = pos - readAt<int32_t>(*data, pos);
+        uint16_t vtableSize = readAt<uint16_t>(*data, vtable);
+        if (4 + 2 * id >= vtableSize)
+            return 0;
+        return readAt<uint16_t>(*data, vtable + 4 + 2 * id);
+    }
+
+    bool has(int id) const
+    {
+        return fieldOffset(id) != 0;
+    }
+
+    template <typename T>
+    T scalar(int id, T defaultValue) const
+    {
+        uint16_t offset = fieldOffset(id);
+        return offset ? readAt<T>(*data, pos + offset) : defaultValue;
+    }
+
+    // Target of an offset field (a table, a vector or a string)
+    uint64_t target(int id) const
+    {
+        uint16_t offset = fieldOffset(id);
+        if (!offset)
+            throw runtime_error("Corrupt Arrow file: missing field");
+        return pos + offset + readAt<uint32_t>(*data, pos + offset);
+    }
+
+    FlatTable table(int id) const
+    {
+        return {data, target(id)};
+    }
+
+    // Start of the elements of a vector field; length receives the element count
+    uint64_t vector(int id, uint32_t &length) const
+    {
+        if (!has(id))
+        {
+            length = 0;
+            return 0;
+        }
+        uint64_t start = target(id);
+        length = readAt<uint32_t>(*data, start);
+        return start + 4;
+    }
+
+    // Table element i of a vector of tables starting at elements
+    FlatTable tableAt(uint64_t elements, uint32_t i) const
+    {
+        uint64_t slot = elements + 4 * (uint64_t)i;
+        return {data, slot + readAt<uint32_t>(*data, slot)};
+    }
+
+    string text(int id) const
+    {
+        if (!has(id))
+            return "";
+        uint64_t start = target(id);
+        uint32_t length = readAt<uint32_t>(*data, start);
+        if (start + 4 + length > data->size())
+            throw runtime_error("Corrupt Arrow file: string out of range");
+        return data->substr(start + 4, length);
+    }
+};
+
+// Root table of a FlatBuffer starting at pos
+static FlatTable rootTable(const string &data, uint64_t pos)
+{
+    return {&data, pos + readAt<uint32_t>(data, pos)};
+}
+
+// Struct to hold the flat layout of one record batch: its length, field nodes and buffers
+struct BatchLayout
+{
+    uint64_t length;
+    uint64_t body;
+    vector<pair<uint64_t, uint64_t>> nodes;   // length, null count
+    vector<pair<uint64_t, uint64_t>> buffers; // offset in body, length
+};
+
+static BatchLayout readBatchLayout(const string &data, const FlatTable &batch, uint64_t body)
+{
+    if (batch.has(3))
+        throw runtime_error("Compressed Arrow files are not supported; write the file uncompressed");
+
+    BatchLayout layout;
+    int64_t batchLength = batch.scalar<int64_t>(0, 0);
+    if (batchLength < 0 || body > data.size())
+        throw runtime_error("Corrupt Arrow file: bad record batch");
+    layout.length = batchLength;
+    layout.body = body;
+    uint32_t count;
+    uint64_t nodes = batch.vector(1, count);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        int64_t length = readAt<int64_t>(data, nodes + 16 * i);
+        int64_t nullCount = readAt<int64_t>(data, nodes + 16 * i + 8);
+        if (length < 0 || nullCount < 0)
+            throw runtime_error("Corrupt Arrow file: bad field node");
+        layout.nodes.push_back({length, nullCount});
+    }
+    uint64_t buffers = batch.vector(2, count);
+    uint64_t room = data.size() - body;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        int64_t offset = readAt<int64_t>(data, buffers + 16 * i);
+        int64_t length = readAt<int64_t>(data, buffers + 16 * i + 8);
+        if (offset < 0 || length < 0 || (uint64_t)offset > room || (uint64_t)length > room - offset)
+            throw runtime_error("Corrupt Arrow file: buffer out of range");
+        layout.buffers.push_back({body + offset, length});
+    }
+    return layout;
+}
+
+// True if row i is valid in the validity bitmap (an empty bitmap means no nulls)
+static bool isValid(const string &data, const pair<uint64_t, uint64_t> &validity, uint64_t i)
+{
+    if (validity.second == 0)
+        return true;
+    return (readAt<uint8_t>(data, validity.first + i / 8) >> (i % 8)) & 1;
+}
+
+// Integer value i of a buffer with the given width and signedness
+static int64_t integerAt(const string &data, uint64_t buffer, uint64_t i, int bitWidth, bool isSigned)
+{
+    switch (bitWidth)
+    {
+    case 8:
+        return isSigned ? (int64_t)readAt<int8_t>(data, buffer + i) : (int64_t)readAt<uint8_t>(data, buffer + i);
+    case 16:
+        return isSigned ? (int64_t)readAt<int16_t>(data, buffer + 2 * i) : (int64_t)readAt<uint16_t>(data, buffer + 2 * i);
+    case 32:
+        return isSigned ? (int64_t)readAt<int32_t>(data, buffer + 4 * i) : (int64_t)readAt<uint32_t>(data, buffer + 4 * i);
+    default:
+        return readAt<int64_t>(data, buffer + 8 * i);
+    }
+}
+
+// Strings of a (large) UTF-8 array; nulls become ""
+static void readStrings(const string &data, const BatchLayout &layout, size_t node, size_t buffer, bool large, vector<string> &out)
+{
+    uint64_t length = layout.nodes[node].first;
+    const auto &validity = layout.buffers[buffer];
+    uint64_t offsets = layout.buffers[buffer + 1].first;
+    uint64_t values = layout.buffers[buffer + 2].first;
+    for (uint64_t i = 0; i < length; ++i)
+    {
+        uint64_t start = large ? readAt<int64_t>(data, offsets + 8 * i) : readAt<int32_t>(data, offsets + 4 * i);
+        uint64_t end = large ? readAt<int64_t>(data, offsets + 8 * i + 8) : readAt<int32_t>(data, offsets + 4 * i + 4);
+        if (!isValid(data, validity, i))
+            out.push_back("");
+        else if (end > data.size() - values || end < start)
+            throw runtime_error("Corrupt Arrow file: string out of range");
+        else
+            out.push_back(data.substr(values + start, end - start));
+    }
+}
+
+ArrowIpcReader::ArrowIpcReader(const string &data)
+    : data(data)
+{
+    readFooter();
+}
+
+// Schema and message blocks from the footer at the end of the file
+void ArrowIpcReader::readFooter()
+{
+    if (data.size() < 18 || data.compare(0, 6, ARROW_MAGIC) != 0 || data.compare(data.size() - 6, 6, ARROW_MAGIC) != 0)
+        throw runtime_error("Not an Arrow IPC file");
+
+    uint64_t footerLength = readAt<int32_t>(data, data.size() - 10);
+    if (footerLength > data.size() - 10)
+        throw runtime_error("Corrupt Arrow file: footer out of range");
+    FlatTable footer = rootTable(data, data.size() - 10 - footerLength);
+
+    FlatTable schema = footer.table(1);
+    uint32_t count;
+    uint64_t schemaFields = schema.vector(1, count);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        FlatTable table = footer.tableAt(schemaFields, i);
+        Field field = {table.text(0), table.scalar<uint8_t>(2, 0), 0, true, -1, 0, true};
+        if (field.type == TYPE_INT)
+        {
+            FlatTable type = table.table(3);
+            field.bitWidth = type.scalar<int32_t>(0, 0);
+            field.isSigned = type.scalar<uint8_t>(1, 0) != 0;
+        }
+        else if (field.type == TYPE_FLOATING_POINT)
+        {
+            FlatTable type = table.table(3);
+            int precision = type.scalar<int16_t>(0, 0);
+            field.bitWidth = precision == 2 ? 64 : precision == 1 ? 32 : 16;
+        }
+        if (table.has(4))
+        {
+            FlatTable dictionary = table.table(4);
+            field.dictionaryId = dictionary.scalar<int64_t>(0, 0);
+            field.indexBitWidth = 32;
+            if (dictionary.has(1))
+            {
+                FlatTable indexType = dictionary.table(1);
+                field.indexBitWidth = indexType.scalar<int32_t>(0, 32);
+                field.indexSigned = indexType.scalar<uint8_t>(1, 0) != 0;
+            }
+        }
+        fields.push_back(field);
+    }
+
+    auto readBlocks = [&](int id, vector<Block> &blocks)
+    {
+        uint64_t elements = footer.vector(id, count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            blocks.push_back({(uint64_t)readAt<int64_t>(data, elements + 24 * i),
+                              (uint64_t)readAt<int32_t>(data, elements + 24 * i + 8),
+                              (uint64_t)readAt<int64_t>(data, elements + 24 * i + 16)});
+        }
+    };
+    readBlocks(2, dictionaryBlocks);
+    readBlocks(3, recordBatchBlocks);
+}
+
+// Message metadata of a block; body receives the start of the message body
+static FlatTable readMessage(const string &data, uint64_t offset, uint64_t metaDataLength, uint64_t &body)
+{
+    uint64_t metadata = offset + 4;
+    if (readAt<uint32_t>(data, offset) == CONTINUATION_MARKER)
+        metadata += 4;
+    body = offset + metaDataLength;
+    return rootTable(data, metadata);
+}
+
+// Values of one dictionary batch; only string dictionaries are supported
+void ArrowIpcReader::readDictionary(const Block &block)
+{
+    uint64_t body;
+    FlatTable message = readMessage(data, block.offset, block.metaDataLength, body);
+    if (message.scalar<uint8_t>(1, 0) != HEADER_DICTIONARY_BATCH)
+        throw runtime_error("Corrupt Arrow file: expected a dictionary batch");
+    FlatTable batch = message.table(2);
+    long id = batch.scalar<int64_t>(0, 0);
+    bool isDelta = batch.scalar<uint8_t>(2, 0) != 0;
+
+    int type = -1;
+    for (const auto &field : fields)
+    {
+        if (field.dictionaryId == id)
+            type = field.type;
+    }
+    if (type != TYPE_UTF8 && type != TYPE_LARGE_UTF8)
+        throw runtime_error("Only string dictionaries are supported in Arrow files");
+
+    BatchLayout layout = readBatchLayout(data, batch.table(1), body);
+    if (layout.nodes.empty() || layout.buffers.size() < 3)
+        throw runtime_error("Corrupt Arrow file: empty dictionary batch");
+    vector<string> &values = dictionaries[id];
+    if (!isDelta)
+        values.clear();
+    readStrings(data, layout, 0, 0, type == TYPE_LARGE_UTF8, values);
+}
+
+// Append the selected columns of one record batch
+void ArrowIpcReader::appendBatch(const Block &block, const vector<int> &selected, vector<RosterColumn> &columns)
+{
+    uint64_t body;
+    FlatTable message = readMessage(data, block.offset, block.metaDataLength, body);
+    if (message.scalar<uint8_t>(1, 0) != HEADER_RECORD_BATCH)
+        throw runtime_error("Corrupt Arrow file: expected a record batch");
+    BatchLayout layout = readBatchLayout(data, message.table(2), body);
+
+    // Buffers are laid out field after field: validity and values, plus offsets for strings
+    vector<size_t> firstBuffer(fields.size());
+    size_t buffer = 0;
+    for (size_t i = 0; i < fields.size(); ++i)
+    {
+        firstBuffer[i] = buffer;
+        const Field &field = fields[i];
+        bool strings = field.dictionaryId == -1 && (field.type == TYPE_UTF8 || field.type == TYPE_LARGE_UTF8);
+        buffer += strings ? 3 : 2;
+    }
+    if (layout.nodes.size() < fields.size() || layout.buffers.size() < buffer)
+        throw runtime_error("Corrupt Arrow file: record batch does not match the schema");
+
+    for (size_t c = 0; c < selected.size(); ++c)
+    {
+        int i = selected[c];
+        const Field &field = fields[i];
+        RosterColumn &column = columns[c];
+        size_t first = firstBuffer[i];
+        const auto &validity = layout.buffers[first];
+        uint64_t values = layout.buffers[first + 1].first;
+        uint64_t length = layout.nodes[i].first;
+
+        if (field.dictionaryId != -1)
+        {
+            const vector<string> &dictionary = dictionaries[field.dictionaryId];
+            for (uint64_t row = 0; row < length; ++row)
+            {
+                int64_t index = isValid(data, validity, row) ? integerAt(data, values, row, field.indexBitWidth, field.indexSigned) : -1;
+                if (index >= (int64_t)dictionary.size())
+                    throw runtime_error("Corrupt Arrow file: dictionary index out of range");
+                column.strings.push_back(index < 0 ? "" : dictionary[index]);
+            }
+        }
+        else if (field.type == TYPE_UTF8 || field.type == TYPE_LARGE_UTF8)
+        {
+            readStrings(data, layout, i, first, field.type == TYPE_LARGE_UTF8, column.strings);
+        }
+        else
+        {
+            size_t start = column.numbers.size();
+            column.numbers.resize(start + length, 0.0);
+            double *out = column.numbers.data() + start;
+            for (uint64_t row = 0; row < length; ++row)
+            {
+                if (!isValid(data, validity, row))
+                    continue;
+                if (field.type == TYPE_INT)
+                    out[row] = integerAt(data, values, row, field.bitWidth, field.isSigned);
+                else if (field.type == TYPE_BOOL)
+                    out[row] = (readAt<uint8_t>(data, values + row / 8) >> (row % 8)) & 1;
+                else if (field.bitWidth == 64)
+                    out[row] = readAt<double>(data, values + 8 * row);
+                else
+                    out[row] = readAt<float>(data, values + 4 * row);
+            }
+        }
+    }
+}
+
+vector<string> ArrowIpcReader::columnNames() const
+{
+    vector<string> names;
+    for (const auto &field : fields)
+    {
+        names.push_back(field.name);
+    }
+    return names;
+}
+
+vector<RosterColumn> ArrowIpcReader::readColumns(const vector<int> &columns)
+{
+    vector<int> selected = columns;
+    if (selected.empty())
+    {
+        for (int i = 0; i < fields.size(); ++i)
+            selected.push_back(i);
+    }
+
+    vector<RosterColumn> result(selected.size());
+    for (size_t c = 0; c < selected.size(); ++c)
+    {
+        if (selected[c] < 0 || selected[c] >= fields.size())
+            throw out_of_range("Invalid column index " + to_string(selected[c]));
+        const Field &field = fields[selected[c]];
+        bool supported = field.type == TYPE_INT || field.type == TYPE_BOOL || field.type == TYPE_UTF8 || field.type == TYPE_LARGE_UTF8 ||
+                         (field.type == TYPE_FLOATING_POINT && field.bitWidth != 16);
+        if (!supported)
+            throw runtime_error("Column \"" + field.name + "\" has an Arrow type that is not supported");
+        result[c].name = field.name;
+        result[c].text = field.dictionaryId != -1 || field.type == TYPE_UTF8 || field.type == TYPE_LARGE_UTF8;
+    }
+    for (const auto &field : fields)
+    {
+        bool flat = field.type == TYPE_INT || field.type == TYPE_FLOATING_POINT || field.type == TYPE_BOOL ||
+                    field.type == TYPE_UTF8 || field.type == TYPE_LARGE_UTF8;
+        if (!flat)
+            throw runtime_error("Column \"" + field.name + "\" is nested or of an unsupported type; only flat tables can be read");
+    }
+
+    for (const auto &block : dictionaryBlocks)
+    {
+        readDictionary(block);
+    }
+    for (const auto &block : recordBatchBlocks)
+    {
+        appendBatch(block, selected, result);
+    }
+    return result;
+}
\ No newline at end of file
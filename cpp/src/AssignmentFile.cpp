@@ -0,0 +1,135 @@
+#include "../include/AssignmentFile.h"
+#include "../include/TeamAggregates.h"
+#include <fstream>
+#include <cstring>
+#include <stdexcept>
+using namespace std;
+
+// Version written in the header; readers reject files with a newer one
+static const uint32_t ASSIGNMENT_FILE_VERSION = 1;
+
+// Round a byte offset up to the next section boundary
+static uint64_t alignSection(uint64_t offset)
+{
+    return (offset + 7) & ~(uint64_t)7;
+}
+
+uint64_t writeAssignmentFile(const string &path, const vector<Team> &teams, const Roster *roster, bool withNames)
+{
+    uint32_t numTeams = teams.size();
+    uint64_t numPersons = roster ? roster->size() : 0;
+    for (const auto &team : teams)
+    {
+        for (const auto &member : team.getmembers())
+        {
+            if (member.getIndex() < 0)
+                throw runtime_error("Teams without roster rows cannot be written as a binary assignment");
+            numPersons = max(numPersons, (uint64_t)member.getIndex() + 1);
+        }
+    }
+
+    // Columns of the assignment, from the teams
+    vector<int32_t> teamOf(numPersons, -1);
+    vector<uint64_t> teamOffsets(numTeams + 1, 0);
+    vector<int32_t> members;
+    vector<double> scores(numTeams, 0.0);
+    vector<string> names(withNames ? numPersons : 0);
+    for (uint32_t team = 0; team < numTeams; ++team)
+    {
+        for (const auto &member : teams[team].getmembers())
+        {
+            teamOf[member.getIndex()] = team;
+            members.push_back(member.getIndex());
+            scores[team] += member.getScore();
+            if (withNames)
+                names[member.getIndex()] = member.getName();
+        }
+        teamOffsets[team + 1] = members.size();
+    }
+    vector<uint64_t> nameOffsets(withNames ? numPersons + 1 : 0, 0);
+    for (uint64_t person = 0; person < names.size(); ++person)
+    {
+        if (roster && person < roster->size() && teamOf[person] == -1)
+            names[person] = roster->getName(person);
+        nameOffsets[person + 1] = nameOffsets[person] + names[person].size();
+    }
+
+    vector<int> categories;
+    vector<vector<double>> categoryTotals;
+    if (roster)
+    {
+        TeamAggregates aggregates(teams, *roster);
+        for (int category = 0; category < roster->numCategories(); ++category)
+        {
+            if (roster->isCategorical(category))
+                continue;
+            categories.push_back(category);
+            categoryTotals.push_back(aggregates.getTotals(category));
+        }
+    }
+
+    AssignmentFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, "TMAS", 4);
+    header.version = ASSIGNMENT_FILE_VERSION;
+    header.numPersons = numPersons;
+    header.numTeams = numTeams;
+    header.numCategories = categories.size();
+    header.teamOfOffset = alignSection(sizeof(header));
+    header.teamOffsetsOffset = alignSection(header.teamOfOffset + numPersons * sizeof(int32_t));
+    header.membersOffset = alignSection(header.teamOffsetsOffset + (numTeams + 1) * sizeof(uint64_t));
+    header.scoresOffset = alignSection(header.membersOffset + members.size() * sizeof(int32_t));
+    header.categoriesOffset = alignSection(header.scoresOffset + numTeams * sizeof(double));
+    header.fileSize = header.categoriesOffset + categories.size() * (8 + numTeams * sizeof(double));
+    if (withNames)
+    {
+        header.nameOffsetsOffset = alignSection(header.fileSize);
+        header.namesOffset = alignSection(header.nameOffsetsOffset + (numPersons + 1) * sizeof(uint64_t));
+        header.fileSize = header.namesOffset + nameOffsets[numPersons];
+    }
+
+    ofstream file(path, ios::binary | ios::trunc);
+    if (!file.is_open())
+    {
+        throw runtime_error("Unable to write assignment file \"" + path + "\"");
+    }
+
+    // Write bytes at the given offset, padding with zeros from the current position
+    uint64_t position = 0;
+    auto writeAt = [&](uint64_t offset, const void *data, size_t bytes)
+    {
+        static const char zeros[8] = {0};
+        file.write(zeros, offset - position);
+        file.write((const char *)data, bytes);
+        position = offset + bytes;
+    };
+    writeAt(0, &header, sizeof(header));
+    writeAt(header.teamOfOffset, teamOf.data(), teamOf.size() * sizeof(int32_t));
+    writeAt(header.teamOffsetsOffset, teamOffsets.data(), teamOffsets.size() * sizeof(uint64_t));
+    writeAt(header.membersOffset, members.data(), members.size() * sizeof(int32_t));
+    writeAt(header.scoresOffset, scores.data(), scores.size() * sizeof(double));
+    uint64_t offset = header.categoriesOffset;
+    for (size_t i = 0; i < categories.size(); ++i)
+    {
+        int32_t index[2] = {categories[i], 0};
+        writeAt(offset, index, sizeof(index));
+        writeAt(position, categoryTotals[i].data(), numTeams * sizeof(double));
+        offset = position;
+    }
+    if (withNames)
+    {
+        writeAt(header.nameOffsetsOffset, nameOffsets.data(), nameOffsets.size() * sizeof(uint64_t));
+        offset = header.namesOffset;
+        for (const auto &name : names)
+        {
+            writeAt(offset, name.data(), name.size());
+            offset = position;
+        }
+    }
+    file.flush();
+    if (!file)
+    {
+        throw runtime_error("Failed writing assignment file \"" + path + "\"");
+    }
+    return header.fileSize;
+}
\ No newline at end of file
@@ -0,0 +1,326 @@
+#include "../include/AssignmentStrategy.h"
+#include "../include/TeamGenerator.h"
+#include "../include/RandomTeamGenerator.h"
+#include "../include/RandomCategoricalTeamGenerator.h"
+#include <chrono>
+#include <sstream>
+using namespace std;
+
+// Largest roster the exact strategy searches, and its time limit when no deadline is given
+static const int EXACT_MAX_PERSONS = 60;
+static const double EXACT_DEFAULT_LIMIT_MS = 1000.0;
+
+// Read the roster a strategy's teams refer to, for strategies whose generator keeps none
+static void readRoster(const StrategyRequest &request, Roster *roster)
+{
+    if (!roster)
+        return;
+    TeamGenerator scoreReader;
+    scoreReader.readPersonsFromFile(request.filename, request.categoryIndices, request.weights);
+    *roster = scoreReader.getRoster();
+}
+
+// Apply the shared categorical options to a generator and create the teams
+static vector<Team> generateCategorical(TeamGenerator &generator, const StrategyRequest &request, Roster *roster)
+{
+    generator.readPersonsFromFile(request.filename, request.categoryIndices, request.weights);
+    generator.setConstraints(request.constraints);
+    generator.setDiversityColumns(request.diversityColumns);
+    generator.setStopFlag(request.stop);
+    vector<Team> teams = generator.createTeams(request.numTeams, request.bounds);
+    if (roster)
+        *roster = generator.getRoster();
+    return teams;
+}
+
+// Strategy wrapping RandomTeamGenerator
+class RandomStrategy : public AssignmentStrategy
+{
+public:
+    StrategyInfo info() const
+    {
+        return {"random", "Generate teams randomly", false, false, true, false, {"min-size", "max-size", "capacities", "threads", "seed"}};
+    }
+
+    vector<Team> generate(const StrategyRequest &request, Roster *roster)
+    {
+        RandomTeamGenerator generator;
+        generator.setSeed(request.seed);
+        generator.readPersonsFromFile(request.filename);
+        vector<Team> teams = generator.createRandomTeams(request.numTeams, request.bounds, request.threads);
+        readRoster(request, roster);
+        return teams;
+    }
+};
+
+// Strategy wrapping TeamGenerator
+class CategoricalStrategy : public AssignmentStrategy
+{
+public:
+    StrategyInfo info() const
+    {
+        return {"categorical", "Generate teams using categories", true, true, false, false,
+                {"constraints", "min-size", "max-size", "capacities", "diversity"}};
+    }
+
+    vector<Team> generate(const StrategyRequest &request, Roster *roster)
+    {
+        TeamGenerator generator;
+        return generateCategorical(generator, request, roster);
+    }
+};
+
+// Strategy wrapping RandomCategoricalTeamGenerator
+class RandomCategoricalStrategy : public AssignmentStrategy
+{
+public:
+    StrategyInfo info() const
+    {
+        return {"random_categorical", "Generate teams randomly with categories", true, false, false, false,
+                {"constraints", "min-size", "max-size", "capacities", "diversity", "jitter", "seed"}};
+    }
+
+    vector<Team> generate(const StrategyRequest &request, Roster *roster)
+    {
+        RandomCategoricalTeamGenerator generator;
+        generator.setJitter(request.jitter);
+        generator.setSeed(request.seed);
+        return generateCategorical(generator, request, roster);
+    }
+};
+
+// Strategy that starts from the categorical teams and refines them until the deadline
+class AnytimeStrategy : public AssignmentStrategy
+{
+public:
+    StrategyInfo info() const
+    {
+        return {"anytime", "Generate teams using categories, refined until a deadline", true, false, true, true,
+                {"constraints", "min-size", "max-size", "capacities", "diversity", "threads", "deadline-ms", "stream"}};
+    }
+
+    vector<Team> generate(const StrategyRequest &request, Roster *roster)
+    {
+        // The deadline covers reading the file and the baseline as well as the refinement
+        auto start = chrono::steady_clock::now();
+        TeamGenerator generator;
+        generateCategorical(generator, request, nullptr);
+
+        double remainingMs = 0.0;
+        if (request.deadlineMs > 0)
+        {
+            double elapsedMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+            remainingMs = max(request.deadlineMs - elapsedMs, 0.001);
+        }
+        vector<Team> teams = generator.refineTeams(remainingMs, request.threads, request.onProgress);
+        if (roster)
+            *roster = generator.getRoster();
+        return teams;
+    }
+};
+
+// Strategy that starts from the categorical teams and balances every category with simulated annealing
+class AnnealingStrategy : public AssignmentStrategy
+{
+public:
+    StrategyInfo info() const
+    {
+        return {"annealing", "Generate teams balanced on every category by simulated annealing", true, false, true, true,
+                {"constraints", "min-size", "max-size", "capacities", "diversity", "threads", "deadline-ms", "iterations"}};
+    }
+
+    vector<Team> generate(const StrategyRequest &request, Roster *roster)
+    {
+        TeamGenerator generator;
+        generateCategorical(generator, request, nullptr);
+        vector<Team> teams = generator.annealTeams(request.iterations, request.deadlineMs, request.threads);
+        if (roster)
+            *roster = generator.getRoster();
+        return teams;
+    }
+};
+
+// Strategy that searches for the most balanced teams of small rosters within a time limit and
+// refines the categorical teams instead for larger rosters or when constraints or diversity
+// categories are given
+class ExactStrategy : public AssignmentStrategy
+{
+public:
+    StrategyInfo info() const
+    {
+        return {"exact", "Generate optimally balanced teams for small rosters", true, false, false, true,
+                {"constraints", "min-size", "max-size", "capacities", "diversity", "deadline-ms"}};
+    }
+
+    vector<Team> generate(const StrategyRequest &request, Roster *roster)
+    {
+        auto start = chrono::steady_clock::now();
+        double limitMs = request.deadlineMs > 0 ? request.deadlineMs : EXACT_DEFAULT_LIMIT_MS;
+
+        TeamGenerator generator;
+        generator.readPersonsFromFile(request.filename, request.categoryIndices, request.weights);
+        generator.setStopFlag(request.stop);
+        vector<Team> teams;
+        if (generator.getRoster().size() <= EXACT_MAX_PERSONS && request.constraints.empty() && request.diversityColumns.empty())
+        {
+            double elapsedMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+            teams = generator.partitionTeams(request.numTeams, request.bounds, max(limitMs - elapsedMs, 0.001));
+        }
+        else
+        {
+            generator.setConstraints(request.constraints);
+            generator.setDiversityColumns(request.diversityColumns);
+            generator.createTeams(request.numTeams, request.bounds);
+            double elapsedMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+            teams = generator.refineTeams(max(limitMs - elapsedMs, 0.001), request.threads);
+        }
+        if (roster)
+            *roster = generator.getRoster();
+        return teams;
+    }
+};
+
+// Register the built-in strategies
+StrategyRegistry::StrategyRegistry()
+{
+    add([]()
+        { return unique_ptr<AssignmentStrategy>(new RandomStrategy()); });
+    add([]()
+        { return unique_ptr<AssignmentStrategy>(new CategoricalStrategy()); });
+    add([]()
+        { return unique_ptr<AssignmentStrategy>(new RandomCategoricalStrategy()); });
+    add([]()
+        { return unique_ptr<AssignmentStrategy>(new AnytimeStrategy()); });
+    add([]()
+        { return unique_ptr<AssignmentStrategy>(new AnnealingStrategy()); });
+    add([]()
+        { return unique_ptr<AssignmentStrategy>(new ExactStrategy()); });
+}
+
+StrategyRegistry &StrategyRegistry::instance()
+{
+    static StrategyRegistry registry;
+    return registry;
+}
+
+void StrategyRegistry::add(Factory factory)
+{
+    StrategyInfo info = factory()->info();
+    strategies.push_back({info, factory});
+}
+
+// A new instance of the named strategy, or null if there is no such strategy
+unique_ptr<AssignmentStrategy> StrategyRegistry::create(const string &name) const
+{
+    for (const auto &strategy : strategies)
+    {
+        if (strategy.first.name == name)
+            return strategy.second();
+    }
+    return nullptr;
+}
+
+vector<StrategyInfo> StrategyRegistry::list() const
+{
+    vector<StrategyInfo> infos;
+    for (const auto &strategy : strategies)
+    {
+        infos.push_back(strategy.first);
+    }
+    return infos;
+}
+
+// The strategy names quoted and separated for error messages, e.g. 'random', 'categorical'
+string StrategyRegistry::names() const
+{
+    string joined;
+    for (size_t i = 0; i < strategies.size(); ++i)
+    {
+        if (i > 0)
+            joined += ", ";
+        joined += "'" + strategies[i].first.name + "'";
+    }
+    return joined;
+}
+
+// Load the keep-together / keep-apart constraints named by the --constraints option, if any
+TeamConstraints loadConstraints(const map<string, string> &options)
+{
+    TeamConstraints constraints;
+    auto it = options.find("constraints");
+    if (it != options.end() && !it->second.empty())
+    {
+        constraints.readFromFile(it->second);
+    }
+    return constraints;
+}
+
+// Read the --min-size, --max-size and --capacities options into team size bounds
+TeamSizeBounds loadSizeBounds(const map<string, string> &options)
+{
+    TeamSizeBounds bounds;
+    auto it = options.find("min-size");
+    if (it != options.end())
+        bounds.minSize = stoi(it->second);
+    it = options.find("max-size");
+    if (it != options.end())
+        bounds.maxSize = stoi(it->second);
+    it = options.find("capacities");
+    if (it != options.end())
+    {
+        istringstream ss(it->second);
+        string capacity;
+        while (getline(ss, capacity, ','))
+        {
+            bounds.capacities.push_back(stoi(capacity));
+        }
+    }
+    return bounds;
+}
+
+// Read the --diversity option: categorical categories whose mix is balanced across teams
+vector<int> loadDiversityColumns(const map<string, string> &options)
+{
+    vector<int> columns;
+    auto it = options.find("diversity");
+    if (it == options.end() || it->second.empty())
+        return columns;
+
+    istringstream ss(it->second);
+    string index;
+    while (getline(ss, index, ','))
+    {
+        columns.push_back(stoi(index));
+    }
+    return columns;
+}
+
+// Collect the inputs of a strategy from the arguments and options
+StrategyRequest buildStrategyRequest(const string &filename, int num_teams, const vector<int> &categoryIndices,
+                                     const vector<double> &weights, const map<string, string> &options)
+{
+    StrategyRequest request;
+    request.filename = filename;
+    request.numTeams = num_teams;
+    request.categoryIndices = categoryIndices;
+    request.weights = weights;
+    request.constraints = loadConstraints(options);
+    request.bounds = loadSizeBounds(options);
+    request.diversityColumns = loadDiversityColumns(options);
+    auto it = options.find("threads");
+    if (it != options.end())
+        request.threads = stoi(it->second);
+    it = options.find("deadline-ms");
+    if (it != options.end())
+        request.deadlineMs = stod(it->second);
+    it = options.find("iterations");
+    if (it != options.end())
+        request.iterations = stol(it->second);
+    it = options.find("jitter");
+    if (it != options.end())
+        request.jitter = stod(it->second);
+    it = options.find("seed");
+    if (it != options.end())
+        request.seed = stoul(it->second);
+    return request;
+}
\ No newline at end of file
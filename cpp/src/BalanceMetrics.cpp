@@ -0,0 +1,89 @@
+#include "../include/BalanceMetrics.h"
+#include <algorithm>
+#include <cmath>
+using namespace std;
+
+CategoryBalance summarizeTotals(int category, const vector<double> &totals)
+{
+    CategoryBalance balance = {category, 0.0, 0.0, 0.0, 0.0};
+    int numTeams = totals.size();
+    if (numTeams == 0)
+        return balance;
+
+    double sum = 0.0;
+    double squares = 0.0;
+    double lowest = totals[0];
+    double highest = totals[0];
+    for (double total : totals)
+    {
+        sum += total;
+        squares += total * total;
+        lowest = min(lowest, total);
+        highest = max(highest, total);
+    }
+    balance.mean = sum / numTeams;
+    balance.stddev = sqrt(max(0.0, squares / numTeams - balance.mean * balance.mean));
+    balance.spread = highest - lowest;
+
+    // Gini coefficient from the sorted totals: sum((2i - n - 1) * x_i) / (n * sum)
+    if (sum != 0.0)
+    {
+        vector<double> sorted = totals;
+        sort(sorted.begin(), sorted.end());
+        double weighted = 0.0;
+        for (int i = 0; i < numTeams; ++i)
+        {
+            weighted += (2.0 * (i + 1) - numTeams - 1) * sorted[i];
+        }
+        balance.gini = weighted / (numTeams * sum);
+    }
+    return balance;
+}
+
+BalanceMetrics::BalanceMetrics(const TeamAggregates &aggregates, const Roster &roster) : roster(roster)
+{
+    for (int category = 0; category < roster.numCategories(); ++category)
+    {
+        if (!roster.isCategorical(category))
+            categories.push_back(summarizeTotals(category, aggregates.getTotals(category)));
+    }
+
+    const vector<int> &sizes = aggregates.getSizes();
+    if (!sizes.empty())
+    {
+        minSize = *min_element(sizes.begin(), sizes.end());
+        maxSize = *max_element(sizes.begin(), sizes.end());
+        vector<double> sizeTotals(sizes.begin(), sizes.end());
+        sizeStddev = summarizeTotals(-1, sizeTotals).stddev;
+    }
+}
+
+const vector<CategoryBalance> &BalanceMetrics::getCategories() const
+{
+    return categories;
+}
+
+// Difference between the largest and the smallest team
+int BalanceMetrics::getSizeImbalance() const
+{
+    return maxSize - minSize;
+}
+
+void BalanceMetrics::printJson(ostream &os) const
+{
+    os << "{\"team_sizes\":{\"min\":" << minSize << ",\"max\":" << maxSize
+       << ",\"imbalance\":" << getSizeImbalance() << ",\"stddev\":" << sizeStddev << "},\"categories\":[";
+    for (size_t i = 0; i < categories.size(); ++i)
+    {
+        const CategoryBalance &balance = categories[i];
+        if (i > 0)
+            os << ",";
+        os << "{\"index\":" << balance.category
+           << ",\"name\":\"" << roster.getHeader(balance.category) << "\""
+           << ",\"mean\":" << balance.mean
+           << ",\"stddev\":" << balance.stddev
+           << ",\"spread\":" << balance.spread
+           << ",\"gini\":" << balance.gini << "}";
+    }
+    os << "]}";
+}
\ No newline at end of file
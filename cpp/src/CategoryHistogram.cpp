@@ -0,0 +1,78 @@
+#include "../include/CategoryHistogram.h"
+using namespace std;
+
+// Each team's quota for a value is its share of the Persons holding that value, rounded up
+void CategoryHistogram::init(const Roster &roster, const vector<int> &columns, const vector<int> &teamSizes)
+{
+    this->roster = &roster;
+    this->columns = columns;
+    slotOffsets.assign(columns.size() + 1, 0);
+    for (size_t i = 0; i < columns.size(); ++i)
+    {
+        slotOffsets[i + 1] = slotOffsets[i] + roster.dictionary(columns[i]).size();
+    }
+    numSlots = slotOffsets.back();
+
+    vector<uint32_t> totals(numSlots, 0);
+    for (size_t i = 0; i < columns.size(); ++i)
+    {
+        for (uint16_t code : roster.codes(columns[i]))
+        {
+            totals[slotOffsets[i] + code]++;
+        }
+    }
+
+    int numTeams = teamSizes.size();
+    long long numPersons = roster.size();
+    counts.assign((size_t)numTeams * numSlots, 0);
+    quotas.assign((size_t)numTeams * numSlots, 0);
+    for (int team = 0; team < numTeams && numPersons > 0; ++team)
+    {
+        uint32_t *quota = quotas.data() + (size_t)team * numSlots;
+        for (int slot = 0; slot < numSlots; ++slot)
+        {
+            quota[slot] = (totals[slot] * (long long)teamSizes[team] + numPersons - 1) / numPersons;
+        }
+    }
+}
+
+bool CategoryHistogram::empty() const
+{
+    return columns.empty();
+}
+
+// True if adding the Person keeps the team at or below its quota for every balanced column
+bool CategoryHistogram::withinQuota(int person, int team) const
+{
+    size_t base = (size_t)team * numSlots;
+    for (size_t i = 0; i < columns.size(); ++i)
+    {
+        size_t slot = base + slotOffsets[i] + roster->codes(columns[i])[person];
+        if (counts[slot] >= quotas[slot])
+            return false;
+    }
+    return true;
+}
+
+void CategoryHistogram::add(int person, int team)
+{
+    size_t base = (size_t)team * numSlots;
+    for (size_t i = 0; i < columns.size(); ++i)
+    {
+        counts[base + slotOffsets[i] + roster->codes(columns[i])[person]]++;
+    }
+}
+
+void CategoryHistogram::remove(int person, int team)
+{
+    size_t base = (size_t)team * numSlots;
+    for (size_t i = 0; i < columns.size(); ++i)
+    {
+        counts[base + slotOffsets[i] + roster->codes(columns[i])[person]]--;
+    }
+}
+
+uint32_t CategoryHistogram::count(int team, int column, int code) const
+{
+    return counts[(size_t)team * numSlots + slotOffsets[column] + code];
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include "../include/ColumnarInput.h"
+#include "../include/ArrowIpcReader.h"
+#include "../include/ParquetReader.h"
+#include <fstream>
+#include <stdexcept>
+using namespace std;
+
+// First bytes of the file, or "" if it cannot be read
+static string fileMagic(const string &filename)
+{
+    ifstream file(filename, ios::binary);
+    char magic[6] = {0};
+    file.read(magic, sizeof(magic));
+    return string(magic, file.gcount());
+}
+
+static bool isArrow(const string &magic)
+{
+    return magic.compare(0, 6, "ARROW1") == 0;
+}
+
+static bool isParquet(const string &magic)
+{
+    return magic.compare(0, 4, "PAR1") == 0;
+}
+
+bool isColumnarFile(const string &filename)
+{
+    string magic = fileMagic(filename);
+    return isArrow(magic) || isParquet(magic);
+}
+
+vector<string> readColumnarHeaders(const string &filename)
+{
+    string data = readWholeFile(filename);
+    if (isArrow(data))
+        return ArrowIpcReader(data).columnNames();
+    if (isParquet(data))
+        return ParquetReader(data).columnNames();
+    throw runtime_error("File \"" + filename + "\" is neither an Arrow IPC nor a Parquet file");
+}
+
+vector<RosterColumn> readColumnarFile(const string &filename, const vector<int> &columns)
+{
+    string data = readWholeFile(filename);
+    if (isArrow(data))
+        return ArrowIpcReader(data).readColumns(columns);
+    if (isParquet(data))
+        return ParquetReader(data).readColumns(columns);
+    throw runtime_error("File \"" + filename + "\" is neither an Arrow IPC nor a Parquet file");
+}
+
+string readWholeFile(const string &filename)
+{
+    ifstream file(filename, ios::binary);
+    if (!file.is_open())
+        throw runtime_error("Could not open file \"" + filename + "\"");
+    file.seekg(0, ios::end);
+    string data(file.tellg(), '\0');
+    file.seekg(0);
+    file.read(&data[0], data.size());
+    if (!file)
+        throw runtime_error("Could not read file \"" + filename + "\"");
+    return data;
+}
\ No newline at end of file
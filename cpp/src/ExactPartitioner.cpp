@@ -0,0 +1,388 @@
+#include "../include/ExactPartitioner.h"
+#include <algorithm>
+#include <numeric>
+#include <queue>
+#include <cstring>
+#include <limits>
+#include <cmath>
+#include <tuple>
+using namespace std;
+
+// Tolerance for comparing spreads, search nodes between clock checks, and the memory for
+// remembered partial states, counting a fixed overhead per state for the hash set
+static const double EPS = 1e-9;
+static const long CHECK_EVERY = 1024;
+static const size_t MEMO_BYTES = 128 << 20;
+static const size_t MEMO_ENTRY_OVERHEAD = 64;
+static const double QUANTUM_SCALE = 1000.0;
+
+ExactPartitioner::ExactPartitioner(const vector<double> &scores, const vector<int> &capacities)
+    : numTeams(capacities.size()), capacities(capacities)
+{
+    int numPersons = scores.size();
+    order.resize(numPersons);
+    iota(order.begin(), order.end(), 0);
+    stable_sort(order.begin(), order.end(), [&](int a, int b)
+                { return scores[a] > scores[b]; });
+
+    sortedScores.resize(numPersons);
+    prefix.assign(numPersons + 1, 0.0);
+    for (int pos = 0; pos < numPersons; ++pos)
+    {
+        sortedScores[pos] = scores[order[pos]];
+        prefix[pos + 1] = prefix[pos] + sortedScores[pos];
+    }
+    average = numTeams > 0 ? prefix[numPersons] / numTeams : 0.0;
+    bestSpread = numeric_limits<double>::infinity();
+
+    // If every score is a multiple of 1 / QUANTUM_SCALE, team totals and spreads are multiples of
+    // the gcd of the scaled scores, which lets the lower bound be rounded up
+    long long divisor = 0;
+    for (double score : sortedScores)
+    {
+        double scaled = score * QUANTUM_SCALE;
+        if (fabs(scaled - llround(scaled)) > 1e-6 || fabs(scaled) > 1e15)
+        {
+            divisor = 0;
+            break;
+        }
+        long long value = llabs(llround(scaled));
+        while (value != 0)
+        {
+            long long rest = divisor % value;
+            divisor = value;
+            value = rest;
+        }
+    }
+    quantum = divisor / QUANTUM_SCALE;
+}
+
+// Improve the assignment (team per position in order) by swapping scores between the heaviest
+// and the lightest team, then keep it if its spread beats the incumbent
+void ExactPartitioner::offer(vector<int> assignment)
+{
+    int numPersons = assignment.size();
+    vector<double> sums(numTeams, 0.0);
+    for (int pos = 0; pos < numPersons; ++pos)
+    {
+        sums[assignment[pos]] += sortedScores[pos];
+    }
+
+    while (true)
+    {
+        int heaviest = max_element(sums.begin(), sums.end()) - sums.begin();
+        int lightest = min_element(sums.begin(), sums.end()) - sums.begin();
+        double gap = sums[heaviest] - sums[lightest];
+
+        // The swap moving the difference closest to half the gap, without creating a new extreme
+        int bestFirst = -1, bestSecond = -1;
+        double bestDistance = gap / 2;
+        for (int first = 0; first < numPersons; ++first)
+        {
+            if (assignment[first] != heaviest)
+                continue;
+            for (int second = 0; second < numPersons; ++second)
+            {
+                double diff = sortedScores[first] - sortedScores[second];
+                if (assignment[second] != lightest || diff <= EPS || diff >= gap - EPS)
+                    continue;
+                double distance = fabs(diff - gap / 2);
+                if (distance < bestDistance - EPS)
+                {
+                    bestDistance = distance;
+                    bestFirst = first;
+                    bestSecond = second;
+                }
+            }
+        }
+        if (bestFirst == -1)
+            break;
+        double diff = sortedScores[bestFirst] - sortedScores[bestSecond];
+        assignment[bestFirst] = lightest;
+        assignment[bestSecond] = heaviest;
+        sums[heaviest] -= diff;
+        sums[lightest] += diff;
+    }
+
+    double spread = *max_element(sums.begin(), sums.end()) - *min_element(sums.begin(), sums.end());
+    if (spread < bestSpread)
+    {
+        bestSpread = spread;
+        bestTeamOf = assignment;
+    }
+}
+
+// Balanced largest differencing: every tier of numTeams consecutive scores is a partial
+// partition with one score per subset, and the two partial partitions with the largest
+// spreads are repeatedly merged, pairing the heaviest subsets of one with the lightest of the
+// other. Only applies when capacities differ by at most one; smaller teams take a placeholder.
+void ExactPartitioner::differencingBound()
+{
+    int numPersons = sortedScores.size();
+    int maxCapacity = *max_element(capacities.begin(), capacities.end());
+    if (maxCapacity - *min_element(capacities.begin(), capacities.end()) > 1)
+        return;
+
+    struct Partial
+    {
+        vector<double> sums;
+        vector<vector<int>> members; // positions in order, -1 for a placeholder
+    };
+    auto spreadOf = [](const Partial &partial)
+    {
+        return *max_element(partial.sums.begin(), partial.sums.end()) - *min_element(partial.sums.begin(), partial.sums.end());
+    };
+    auto byLargerSpread = [&](const pair<double, int> &a, const pair<double, int> &b)
+    {
+        return a.first < b.first;
+    };
+
+    vector<Partial> partials;
+    priority_queue<pair<double, int>, vector<pair<double, int>>, decltype(byLargerSpread)> heap(byLargerSpread);
+    for (int tier = 0; tier < maxCapacity; ++tier)
+    {
+        Partial partial;
+        for (int slot = 0; slot < numTeams; ++slot)
+        {
+            int pos = tier * numTeams + slot;
+            bool real = pos < numPersons;
+            partial.sums.push_back(real ? sortedScores[pos] : 0.0);
+            partial.members.push_back({real ? pos : -1});
+        }
+        partials.push_back(partial);
+        heap.push({spreadOf(partials.back()), (int)partials.size() - 1});
+    }
+
+    while (heap.size() > 1)
+    {
+        Partial &first = partials[heap.top().second];
+        heap.pop();
+        Partial &second = partials[heap.top().second];
+        heap.pop();
+
+        vector<int> heavy(numTeams), light(numTeams);
+        iota(heavy.begin(), heavy.end(), 0);
+        iota(light.begin(), light.end(), 0);
+        sort(heavy.begin(), heavy.end(), [&](int a, int b)
+             { return first.sums[a] > first.sums[b]; });
+        sort(light.begin(), light.end(), [&](int a, int b)
+             { return second.sums[a] < second.sums[b]; });
+
+        Partial merged;
+        for (int slot = 0; slot < numTeams; ++slot)
+        {
+            merged.sums.push_back(first.sums[heavy[slot]] + second.sums[light[slot]]);
+            merged.members.push_back(first.members[heavy[slot]]);
+            const vector<int> &extra = second.members[light[slot]];
+            merged.members.back().insert(merged.members.back().end(), extra.begin(), extra.end());
+        }
+        partials.push_back(merged);
+        heap.push({spreadOf(partials.back()), (int)partials.size() - 1});
+    }
+
+    // Subsets holding a placeholder go to the smaller teams
+    const Partial &result = partials[heap.top().second];
+    vector<int> largeTeams, smallTeams;
+    for (int team = 0; team < numTeams; ++team)
+    {
+        (capacities[team] == maxCapacity ? largeTeams : smallTeams).push_back(team);
+    }
+    vector<int> assignment(numPersons, -1);
+    for (const auto &members : result.members)
+    {
+        bool small = find(members.begin(), members.end(), -1) != members.end();
+        vector<int> &teams = small ? smallTeams : largeTeams;
+        if (teams.empty())
+            return;
+        int team = teams.back();
+        teams.pop_back();
+        for (int pos : members)
+        {
+            if (pos != -1)
+                assignment[pos] = team;
+        }
+    }
+    offer(assignment);
+}
+
+// Greedy: every score in descending order goes to the lightest team with room
+void ExactPartitioner::greedyBound()
+{
+    vector<double> sums(numTeams, 0.0);
+    vector<int> sizes(numTeams, 0);
+    vector<int> assignment(sortedScores.size());
+    for (int pos = 0; pos < sortedScores.size(); ++pos)
+    {
+        int lightest = -1;
+        for (int team = 0; team < numTeams; ++team)
+        {
+            if (sizes[team] < capacities[team] && (lightest == -1 || sums[team] < sums[lightest]))
+                lightest = team;
+        }
+        assignment[pos] = lightest;
+        sums[lightest] += sortedScores[pos];
+        sizes[lightest]++;
+    }
+    offer(assignment);
+}
+
+// Lower bound on the final spread with the scores from position next onwards unassigned. A
+// team with r free places ends between its total plus the r smallest and plus the r largest
+// remaining scores; the final maximum is also at least the average and the minimum at most it.
+double ExactPartitioner::lowerBound(int next) const
+{
+    int numPersons = sortedScores.size();
+    double highestLow = average;
+    double lowestHigh = average;
+    for (int team = 0; team < numTeams; ++team)
+    {
+        int free = capacities[team] - counts[team];
+        double low = totals[team] + prefix[numPersons] - prefix[numPersons - free];
+        double high = totals[team] + prefix[next + free] - prefix[next];
+        highestLow = max(highestLow, low);
+        lowestHigh = min(lowestHigh, high);
+    }
+    double bound = highestLow - lowestHigh;
+    if (quantum > 0)
+    {
+        // Equal totals need the total to split evenly into numTeams multiples of the quantum
+        double units = llround(prefix[numPersons] / quantum);
+        if (fmod(units, numTeams) != 0)
+            bound = max(bound, quantum);
+        bound = ceil(bound / quantum - 1e-6) * quantum;
+    }
+    return bound;
+}
+
+// Canonical form of the partial state: the next position and the multiset of team (total,
+// size, capacity), sorted and packed into bytes. Two states share a key only if they are equal.
+void ExactPartitioner::stateKey(int next, string &key) const
+{
+    struct TeamState
+    {
+        uint64_t total;
+        int32_t count;
+        int32_t capacity;
+    };
+    vector<TeamState> teamStates(numTeams);
+    for (int team = 0; team < numTeams; ++team)
+    {
+        memcpy(&teamStates[team].total, &totals[team], sizeof(uint64_t));
+        teamStates[team].count = counts[team];
+        teamStates[team].capacity = capacities[team];
+    }
+    sort(teamStates.begin(), teamStates.end(), [](const TeamState &a, const TeamState &b)
+         { return tie(a.total, a.count, a.capacity) < tie(b.total, b.count, b.capacity); });
+
+    int32_t position = next;
+    key.assign((const char *)&position, sizeof(position));
+    key.append((const char *)teamStates.data(), teamStates.size() * sizeof(TeamState));
+}
+
+void ExactPartitioner::search(int next)
+{
+    if (timedOut)
+        return;
+    if (++nodes % CHECK_EVERY == 0 && (Clock::now() >= deadline || (stop && stop->load(memory_order_relaxed))))
+    {
+        timedOut = true;
+        return;
+    }
+
+    if (next == sortedScores.size())
+    {
+        double spread = *max_element(totals.begin(), totals.end()) - *min_element(totals.begin(), totals.end());
+        if (spread < bestSpread - EPS)
+        {
+            bestSpread = spread;
+            bestTeamOf = teamOf;
+        }
+        return;
+    }
+    if (lowerBound(next) >= bestSpread - EPS)
+        return;
+
+    string key;
+    stateKey(next, key);
+    if (explored.count(key))
+        return;
+    if (exploredBytes + key.size() + MEMO_ENTRY_OVERHEAD <= MEMO_BYTES)
+    {
+        exploredBytes += key.size() + MEMO_ENTRY_OVERHEAD;
+        explored.insert(move(key));
+    }
+
+    // Try the teams with room from the lightest, skipping teams identical to one already tried
+    vector<int> candidates;
+    for (int team = 0; team < numTeams; ++team)
+    {
+        if (counts[team] < capacities[team])
+            candidates.push_back(team);
+    }
+    sort(candidates.begin(), candidates.end(), [&](int a, int b)
+         { return totals[a] < totals[b]; });
+    for (int i = 0; i < candidates.size(); ++i)
+    {
+        int team = candidates[i];
+        bool duplicate = false;
+        for (int j = 0; j < i && !duplicate; ++j)
+        {
+            int other = candidates[j];
+            duplicate = totals[other] == totals[team] && counts[other] == counts[team] && capacities[other] == capacities[team];
+        }
+        if (duplicate)
+            continue;
+
+        totals[team] += sortedScores[next];
+        counts[team]++;
+        teamOf[next] = team;
+        search(next + 1);
+        totals[team] -= sortedScores[next];
+        counts[team]--;
+        if (timedOut || bestSpread <= lowerBound(next) + EPS)
+            return;
+    }
+}
+
+// End the search as soon as *stop is set, like at the time limit
+void ExactPartitioner::setStopFlag(const atomic<bool> *stop)
+{
+    this->stop = stop;
+}
+
+// Best assignment found within limitMs milliseconds, as the team of every Person
+vector<int> ExactPartitioner::solve(double limitMs)
+{
+    int numPersons = sortedScores.size();
+    deadline = Clock::now() + chrono::duration_cast<Clock::duration>(chrono::duration<double, milli>(limitMs));
+    differencingBound();
+    greedyBound();
+
+    totals.assign(numTeams, 0.0);
+    counts.assign(numTeams, 0);
+    teamOf.assign(numPersons, -1);
+    explored.clear();
+    exploredBytes = 0;
+    nodes = 0;
+    timedOut = false;
+    if (bestSpread > lowerBound(0) + EPS)
+        search(0);
+    optimal = !timedOut;
+
+    vector<int> result(numPersons);
+    for (int pos = 0; pos < numPersons; ++pos)
+    {
+        result[order[pos]] = bestTeamOf[pos];
+    }
+    return result;
+}
+
+bool ExactPartitioner::isOptimal() const
+{
+    return optimal;
+}
+
+double ExactPartitioner::getSpread() const
+{
+    return bestSpread;
+}
\ No newline at end of file
@@ -0,0 +1,149 @@
+#include "../include/HierarchicalPartitioner.h"
+#include "../include/AnytimeOptimizer.h"
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+using namespace std;
+
+HierarchicalPartitioner::HierarchicalPartitioner(const vector<double> &scores, const vector<int> &swapClass, const vector<int> &fanOut)
+    : scores(scores), swapClass(swapClass), fanOut(fanOut)
+{
+    long groups = 1;
+    for (int count : fanOut)
+    {
+        if (count <= 0)
+            throw invalid_argument("Every level needs a positive number of groups");
+        groups *= count;
+        if (groups > (long)scores.size())
+            throw invalid_argument("The hierarchy has more groups than there are Persons");
+    }
+}
+
+// Split the node into numGroups children. Each swap class is dealt in descending score order:
+// whole rounds in a zig-zag pattern, then the rest to the smallest children so far.
+void HierarchicalPartitioner::split(HierarchyNode &node, int numGroups, int threads) const
+{
+    int size = node.members.size();
+    map<int, vector<int>> classes; // local positions by swap class, in descending score order
+    for (int i = 0; i < size; ++i)
+    {
+        classes[swapClass[node.members[i]]].push_back(i);
+    }
+
+    vector<int> teamOf(size);
+    vector<int> sizes(numGroups, 0);
+    for (const auto &entry : classes)
+    {
+        const vector<int> &positions = entry.second;
+        int rounds = positions.size() / numGroups;
+        int dealt = 0;
+        for (int round = 0; round < rounds; ++round)
+        {
+            for (int i = 0; i < numGroups; ++i)
+            {
+                teamOf[positions[dealt++]] = round % 2 == 0 ? i : numGroups - 1 - i;
+            }
+        }
+        for (int i = 0; i < numGroups; ++i)
+        {
+            sizes[i] += rounds;
+        }
+        vector<int> smallest(numGroups);
+        for (int i = 0; i < numGroups; ++i)
+            smallest[i] = i;
+        stable_sort(smallest.begin(), smallest.end(), [&](int a, int b)
+                    { return sizes[a] < sizes[b]; });
+        for (int i = 0; dealt < positions.size(); ++i)
+        {
+            teamOf[positions[dealt++]] = smallest[i];
+            sizes[smallest[i]]++;
+        }
+    }
+
+    // Even out the totals with swaps that keep every child's size and class counts
+    vector<double> localScores(size);
+    vector<int> localClass(size);
+    for (int i = 0; i < size; ++i)
+    {
+        localScores[i] = scores[node.members[i]];
+        localClass[i] = swapClass[node.members[i]];
+    }
+    AnytimeOptimizer optimizer(localScores, localClass, teamOf, numGroups);
+    teamOf = optimizer.run(0.0, threads);
+
+    node.children.assign(numGroups, HierarchyNode());
+    for (int i = 0; i < size; ++i)
+    {
+        HierarchyNode &child = node.children[teamOf[i]];
+        child.members.push_back(node.members[i]);
+        child.total += localScores[i];
+    }
+}
+
+// Split the node with fanOut[level] children, then every child's subtree as a task of the group
+void HierarchicalPartitioner::splitSubtree(HierarchyNode &node, int level, int threads, TaskGroup &group) const
+{
+    if (level == fanOut.size())
+        return;
+    split(node, fanOut[level], threads);
+    for (auto &child : node.children)
+    {
+        HierarchyNode *subtree = &child;
+        group.run([this, subtree, level, &group]()
+                  { splitSubtree(*subtree, level + 1, 1, group); });
+    }
+}
+
+// Build the whole hierarchy; the top split uses every thread in its optimizer
+const HierarchyNode &HierarchicalPartitioner::run(int threads)
+{
+    root = HierarchyNode();
+    root.members.resize(scores.size());
+    for (int i = 0; i < scores.size(); ++i)
+    {
+        root.members[i] = i;
+        root.total += scores[i];
+    }
+    stable_sort(root.members.begin(), root.members.end(), [&](int a, int b)
+                { return scores[a] > scores[b]; });
+
+    TaskGroup group;
+    splitSubtree(root, 0, threads, group);
+    group.wait();
+    return root;
+}
+
+const HierarchyNode &HierarchicalPartitioner::getRoot() const
+{
+    return root;
+}
+
+// Group of every Person at the given level (0 for the top level), numbering the groups of the
+// level from left to right across parents; numGroups receives their count
+vector<int> HierarchicalPartitioner::levelAssignment(const HierarchyNode &root, int level, int numPersons, int &numGroups)
+{
+    vector<const HierarchyNode *> nodes = {&root};
+    for (int depth = 0; depth <= level; ++depth)
+    {
+        vector<const HierarchyNode *> children;
+        for (const HierarchyNode *node : nodes)
+        {
+            for (const auto &child : node->children)
+            {
+                children.push_back(&child);
+            }
+        }
+        nodes = children;
+    }
+
+    vector<int> groupOf(numPersons, -1);
+    for (int group = 0; group < nodes.size(); ++group)
+    {
+        for (int person : nodes[group]->members)
+        {
+            groupOf[person] = group;
+        }
+    }
+    numGroups = nodes.size();
+    return groupOf;
+}
\ No newline at end of file
@@ -0,0 +1,200 @@
+#include "../include/JobQueue.h"
+#include <stdexcept>
+#include <algorithm>
+using namespace std;
+
+const char *jobStateName(JobState state)
+{
+    switch (state)
+    {
+    case JobState::Queued:
+        return "queued";
+    case JobState::Running:
+        return "running";
+    case JobState::Done:
+        return "done";
+    case JobState::Failed:
+        return "failed";
+    case JobState::Cancelled:
+        return "cancelled";
+    }
+    return "unknown";
+}
+
+JobQueue::JobQueue(int numWorkers, size_t capacity, size_t keepFinished)
+    : capacity(capacity), keepFinished(keepFinished)
+{
+    for (int i = 0; i < max(1, numWorkers); ++i)
+    {
+        workers.emplace_back(&JobQueue::workerLoop, this);
+    }
+}
+
+// Stop the running jobs at their next check and wait for the workers; queued jobs never start
+JobQueue::~JobQueue()
+{
+    {
+        lock_guard<mutex> lock(queueMutex);
+        stopping = true;
+        for (auto &entry : jobs)
+            entry.second->stop = true;
+    }
+    jobReady.notify_all();
+    for (thread &worker : workers)
+        worker.join();
+}
+
+// Queue a request for the named strategy; returns the job id. Throws invalid_argument for an
+// unknown strategy and runtime_error if the queue is full.
+long JobQueue::submit(const string &generationType, const StrategyRequest &request, int priority)
+{
+    if (!StrategyRegistry::instance().create(generationType))
+        throw invalid_argument("Invalid generation type. Must be one of " + StrategyRegistry::instance().names());
+
+    shared_ptr<Job> job = make_shared<Job>();
+    job->priority = priority;
+    job->generationType = generationType;
+    job->request = request;
+    {
+        lock_guard<mutex> lock(queueMutex);
+        if (pending.size() >= capacity)
+            throw runtime_error("The job queue is full (" + to_string(capacity) + " jobs waiting)");
+        job->id = nextId++;
+        jobs[job->id] = job;
+        pending.insert({-priority, job->id});
+    }
+    jobReady.notify_one();
+    return job->id;
+}
+
+void JobQueue::workerLoop()
+{
+    while (true)
+    {
+        shared_ptr<Job> job;
+        {
+            unique_lock<mutex> lock(queueMutex);
+            jobReady.wait(lock, [&]
+                          { return stopping || !pending.empty(); });
+            if (stopping)
+                return;
+            job = jobs[pending.begin()->second];
+            pending.erase(pending.begin());
+            job->state = JobState::Running;
+            job->started = Clock::now();
+        }
+        run(*job);
+    }
+}
+
+// Run a job with its strategy, counting the better assignments it reports
+void JobQueue::run(Job &job)
+{
+    StrategyRequest request = job.request;
+    request.stop = &job.stop;
+    request.onProgress = [&](const vector<Team> &, double stddev, double)
+    {
+        lock_guard<mutex> lock(queueMutex);
+        job.improvements++;
+        job.stddev = stddev;
+    };
+
+    try
+    {
+        vector<Team> teams = StrategyRegistry::instance().create(job.generationType)->generate(request, nullptr);
+        lock_guard<mutex> lock(queueMutex);
+        job.teams = move(teams);
+        finish(job, job.stop ? JobState::Cancelled : JobState::Done);
+    }
+    catch (const exception &e)
+    {
+        lock_guard<mutex> lock(queueMutex);
+        job.error = e.what();
+        finish(job, job.stop ? JobState::Cancelled : JobState::Failed);
+    }
+}
+
+// Move a job to a final state and forget the oldest finished jobs beyond the limit;
+// queueMutex must be held
+void JobQueue::finish(Job &job, JobState state)
+{
+    if (job.state == JobState::Running)
+        job.elapsedMs = chrono::duration<double, milli>(Clock::now() - job.started).count();
+    job.state = state;
+    if (state != JobState::Done)
+        job.teams.clear();
+    finished.push_back(job.id);
+    while (finished.size() > keepFinished)
+    {
+        jobs.erase(finished.front());
+        finished.erase(finished.begin());
+    }
+}
+
+// queueMutex must be held
+void JobQueue::fillStatus(const Job &job, JobStatus &status) const
+{
+    status.id = job.id;
+    status.state = job.state;
+    status.priority = job.priority;
+    status.queuePosition = 0;
+    if (job.state == JobState::Queued)
+        status.queuePosition = distance(pending.begin(), pending.find({-job.priority, job.id}));
+    status.improvements = job.improvements;
+    status.stddev = job.stddev;
+    status.elapsedMs = job.elapsedMs;
+    if (job.state == JobState::Running)
+        status.elapsedMs = chrono::duration<double, milli>(Clock::now() - job.started).count();
+    status.error = job.error;
+}
+
+// Status of a job; false if there is no such job (any more)
+bool JobQueue::status(long id, JobStatus &status) const
+{
+    lock_guard<mutex> lock(queueMutex);
+    auto it = jobs.find(id);
+    if (it == jobs.end())
+        return false;
+    fillStatus(*it->second, status);
+    return true;
+}
+
+// Cancel a queued or running job; false if it does not exist or has already finished
+bool JobQueue::cancel(long id)
+{
+    lock_guard<mutex> lock(queueMutex);
+    auto it = jobs.find(id);
+    if (it == jobs.end())
+        return false;
+    Job &job = *it->second;
+    if (job.state == JobState::Queued)
+    {
+        pending.erase({-job.priority, job.id});
+        finish(job, JobState::Cancelled);
+        return true;
+    }
+    if (job.state == JobState::Running)
+    {
+        job.stop = true;
+        return true;
+    }
+    return false;
+}
+
+// Status of a job and, once it has finished, its teams (empty unless it is done); finished
+// jobs are forgotten afterwards. False if there is no such job.
+bool JobQueue::takeResult(long id, vector<Team> &teams, JobStatus &status)
+{
+    lock_guard<mutex> lock(queueMutex);
+    auto it = jobs.find(id);
+    if (it == jobs.end())
+        return false;
+    shared_ptr<Job> job = it->second;
+    fillStatus(*job, status);
+    if (job->state == JobState::Queued || job->state == JobState::Running)
+        return true;
+    teams = move(job->teams);
+    jobs.erase(it);
+    finished.erase(find(finished.begin(), finished.end(), id));
+    return true;
+}
\ No newline at end of file
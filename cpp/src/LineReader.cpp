@@ -0,0 +1,208 @@
+#include "../include/LineReader.h"
+#include <cstring>
+#include <stdexcept>
+#include <zlib.h>
+using namespace std;
+
+// Blocks in the ring between the decompression thread and the reader, and the size of every
+// block; the ring bounds the inflated data held in memory to a few megabytes
+static const size_t RING_BLOCKS = 8;
+static const size_t RING_BLOCK_BYTES = 1 << 20;
+
+// Compressed bytes read from the file per call to inflate()
+static const size_t INFLATE_INPUT_BYTES = 256 * 1024;
+
+bool isGzipFile(const string &filename)
+{
+    ifstream file(filename, ios::binary);
+    unsigned char magic[2] = {0, 0};
+    file.read((char *)magic, 2);
+    return file.gcount() == 2 && magic[0] == 0x1f && magic[1] == 0x8b;
+}
+
+LineReader::LineReader(const string &filename)
+    : file(filename, ios::binary)
+{
+    if (!file.is_open())
+        return;
+    unsigned char magic[2] = {0, 0};
+    file.read((char *)magic, 2);
+    compressed = file.gcount() == 2 && magic[0] == 0x1f && magic[1] == 0x8b;
+    file.clear();
+    file.seekg(0);
+
+    if (compressed)
+    {
+        ring.resize(RING_BLOCKS);
+        inflater = thread(&LineReader::inflateFile, this);
+    }
+}
+
+LineReader::~LineReader()
+{
+    {
+        lock_guard<mutex> lock(ringMutex);
+        stopping = true;
+    }
+    blockFreed.notify_all();
+    if (inflater.joinable())
+        inflater.join();
+}
+
+bool LineReader::isOpen() const
+{
+    return file.is_open();
+}
+
+bool LineReader::isCompressed() const
+{
+    return compressed;
+}
+
+// Body of the decompression thread: fill free ring blocks until the file ends. Concatenated
+// gzip members are read one after the other, like gunzip does.
+void LineReader::inflateFile()
+{
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    string failure;
+    if (inflateInit2(&stream, 15 + 32) != Z_OK)
+        failure = "Could not start gzip decompression";
+
+    vector<char> input(INFLATE_INPUT_BYTES);
+    bool done = !failure.empty();
+    while (!done)
+    {
+        size_t slot;
+        {
+            unique_lock<mutex> lock(ringMutex);
+            blockFreed.wait(lock, [&]
+                            { return count < RING_BLOCKS || stopping; });
+            if (stopping)
+                break;
+            slot = (head + count) % RING_BLOCKS;
+        }
+
+        // The slot is not visible to the reader until it is counted, so fill it unlocked
+        string &out = ring[slot];
+        out.resize(RING_BLOCK_BYTES);
+        stream.next_out = (Bytef *)&out[0];
+        stream.avail_out = RING_BLOCK_BYTES;
+        while (stream.avail_out > 0)
+        {
+            if (stream.avail_in == 0)
+            {
+                file.read(input.data(), input.size());
+                stream.next_in = (Bytef *)input.data();
+                stream.avail_in = file.gcount();
+                if (stream.avail_in == 0)
+                {
+                    // The input ran out before the end of the gzip stream
+                    failure = "Truncated gzip file";
+                    done = true;
+                    break;
+                }
+            }
+            int result = inflate(&stream, Z_NO_FLUSH);
+            if (result == Z_STREAM_END)
+            {
+                if (stream.avail_in == 0 && file.peek() == ifstream::traits_type::eof())
+                {
+                    done = true;
+                    break;
+                }
+                inflateReset(&stream);
+            }
+            else if (result != Z_OK && result != Z_BUF_ERROR)
+            {
+                failure = string("Corrupt gzip file: ") + (stream.msg ? stream.msg : "inflate failed");
+                done = true;
+                break;
+            }
+        }
+        out.resize(RING_BLOCK_BYTES - stream.avail_out);
+
+        lock_guard<mutex> lock(ringMutex);
+        if (!out.empty())
+        {
+            ++count;
+            blockFilled.notify_one();
+        }
+    }
+    inflateEnd(&stream);
+
+    lock_guard<mutex> lock(ringMutex);
+    finished = true;
+    error = failure;
+    blockFilled.notify_all();
+}
+
+// Make the next block of the file the current one; false at the end of the file
+bool LineReader::nextBlock()
+{
+    pos = 0;
+    if (!compressed)
+    {
+        block.resize(RING_BLOCK_BYTES);
+        file.read(&block[0], block.size());
+        block.resize(file.gcount());
+        return !block.empty();
+    }
+
+    unique_lock<mutex> lock(ringMutex);
+    blockFilled.wait(lock, [&]
+                     { return count > 0 || finished; });
+    if (count == 0)
+    {
+        block.clear();
+        if (!error.empty())
+            throw runtime_error(error);
+        return false;
+    }
+    block.swap(ring[head]);
+    head = (head + 1) % RING_BLOCKS;
+    --count;
+    blockFreed.notify_one();
+    return true;
+}
+
+// True if no bytes are left to read
+bool LineReader::atEnd()
+{
+    return pos >= block.size() && !nextBlock();
+}
+
+// Next line without its '\n', like std::getline; false once the file is exhausted
+bool LineReader::getline(string &line)
+{
+    line.clear();
+    bool any = false;
+    while (true)
+    {
+        if (pos >= block.size() && !nextBlock())
+            return any;
+        any = true;
+        const char *start = block.data() + pos;
+        const char *newline = (const char *)memchr(start, '\n', block.size() - pos);
+        if (newline)
+        {
+            line.append(start, newline);
+            pos = newline - block.data() + 1;
+            return true;
+        }
+        line.append(start, block.size() - pos);
+        pos = block.size();
+    }
+}
+
+// The rest of the file in one string
+string LineReader::readAll()
+{
+    string all = block.substr(min(pos, block.size()));
+    while (nextBlock())
+    {
+        all += block;
+    }
+    pos = block.size();
+    return all;
+}
\ No newline at end of file
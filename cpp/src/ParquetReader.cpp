@@ -0,0 +1,780 @@
+#include "../include/ParquetReader.h"
+#include <cstring>
+#include <stdexcept>
+#include <zlib.h>
+using namespace std;
+
+// Parquet physical types, repetition types, page types, encodings and codecs used by this
+// reader (see parquet.thrift in the Parquet format specification)
+static const int TYPE_BOOLEAN = 0;
+static const int TYPE_INT32 = 1;
+static const int TYPE_INT64 = 2;
+static const int TYPE_FLOAT = 4;
+static const int TYPE_DOUBLE = 5;
+static const int TYPE_BYTE_ARRAY = 6;
+static const int REPETITION_OPTIONAL = 1;
+static const int REPETITION_REPEATED = 2;
+static const int PAGE_DATA = 0;
+static const int PAGE_DICTIONARY = 2;
+static const int PAGE_DATA_V2 = 3;
+static const int ENCODING_PLAIN = 0;
+static const int ENCODING_PLAIN_DICTIONARY = 2;
+static const int ENCODING_RLE = 3;
+static const int ENCODING_RLE_DICTIONARY = 8;
+static const int CODEC_UNCOMPRESSED = 0;
+static const int CODEC_SNAPPY = 1;
+static const int CODEC_GZIP = 2;
+
+// Thrift compact protocol field types
+static const int THRIFT_STOP = 0;
+static const int THRIFT_TRUE = 1;
+static const int THRIFT_FALSE = 2;
+static const int THRIFT_BYTE = 3;
+static const int THRIFT_I16 = 4;
+static const int THRIFT_I32 = 5;
+static const int THRIFT_I64 = 6;
+static const int THRIFT_DOUBLE = 7;
+static const int THRIFT_BINARY = 8;
+static const int THRIFT_LIST = 9;
+static const int THRIFT_SET = 10;
+static const int THRIFT_MAP = 11;
+static const int THRIFT_STRUCT = 12;
+
+// Magic bytes at both ends of a Parquet file
+static const char PARQUET_MAGIC[] = "PAR1";
+
+static void corrupt(const string &what)
+{
+    throw runtime_error("Corrupt Parquet file: " + what);
+}
+
+// Struct to read Thrift compact protocol values in place
+struct ThriftReader
+{
+    const string &data;
+    uint64_t pos;
+
+    uint8_t byte()
+    {
+        if (pos >= data.size())
+            corrupt("metadata out of range");
+        return data[pos++];
+    }
+
+    uint64_t varint()
+    {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7)
+        {
+            uint8_t b = byte();
+            value |= (uint64_t)(b & 0x7F) << shift;
+            if (!(b & 0x80))
+                return value;
+        }
+        corrupt("varint too long");
+        return 0;
+    }
+
+    int64_t integer()
+    {
+        uint64_t value = varint();
+        return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+    }
+
+    string binary()
+    {
+        uint64_t length = varint();
+        if (length > data.size() - pos)
+            corrupt("string out of range");
+        string value = data.substr(pos, length);
+        pos += length;
+        return value;
+    }
+
+    // Next field of a struct; returns false at the end of the struct
+    bool field(int &id, int &type)
+    {
+        uint8_t header = byte();
+        type = header & 0x0F;
+        if (type == THRIFT_STOP)
+            return false;
+        id = (header >> 4) ? id + (header >> 4) : (int)integer();
+        return true;
+    }
+
+    // Header of a list or set; returns the element count
+    uint64_t list(int &elementType)
+    {
+        uint8_t header = byte();
+        elementType = header & 0x0F;
+        return (header >> 4) == 15 ? varint() : (header >> 4);
+    }
+
+    bool boolean(int type)
+    {
+        return type == THRIFT_TRUE;
+    }
+
+    void skip(int type)
+    {
+        switch (type)
+        {
+        case THRIFT_TRUE:
+        case THRIFT_FALSE:
+            break;
+        case THRIFT_BYTE:
+            byte();
+            break;
+        case THRIFT_I16:
+        case THRIFT_I32:
+        case THRIFT_I64:
+            varint();
+            break;
+        case THRIFT_DOUBLE:
+            pos += 8;
+            break;
+        case THRIFT_BINARY:
+            pos += varint();
+            break;
+        case THRIFT_LIST:
+        case THRIFT_SET:
+        {
+            int elementType;
+            uint64_t count = list(elementType);
+            for (uint64_t i = 0; i < count; ++i)
+            {
+                // Booleans inside lists take a whole byte
+                if (elementType == THRIFT_TRUE || elementType == THRIFT_FALSE)
+                    byte();
+                else
+                    skip(elementType);
+            }
+            break;
+        }
+        case THRIFT_MAP:
+        {
+            uint64_t count = varint();
+            if (count == 0)
+                break;
+            uint8_t types = byte();
+            for (uint64_t i = 0; i < count; ++i)
+            {
+                skip(types >> 4);
+                skip(types & 0x0F);
+            }
+            break;
+        }
+        case THRIFT_STRUCT:
+        {
+            int id = 0, fieldType;
+            while (field(id, fieldType))
+                skip(fieldType);
+            break;
+        }
+        default:
+            corrupt("unknown Thrift type");
+        }
+    }
+};
+
+// Struct to hold the fields of a page header that the reader needs
+struct PageHeader
+{
+    int type = -1;
+    int64_t uncompressedSize = 0;
+    int64_t compressedSize = 0;
+    int64_t numValues = 0;
+    int encoding = ENCODING_PLAIN;
+    int64_t definitionLevelsLength = 0;
+    int64_t repetitionLevelsLength = 0;
+    bool isCompressed = true;
+};
+
+static PageHeader readPageHeader(ThriftReader &reader)
+{
+    PageHeader header;
+    int id = 0, type;
+    while (reader.field(id, type))
+    {
+        if (id == 1 && type == THRIFT_I32)
+            header.type = reader.integer();
+        else if (id == 2 && type == THRIFT_I32)
+            header.uncompressedSize = reader.integer();
+        else if (id == 3 && type == THRIFT_I32)
+            header.compressedSize = reader.integer();
+        else if ((id == 5 || id == 7 || id == 8) && type == THRIFT_STRUCT)
+        {
+            // DataPageHeader, DictionaryPageHeader and DataPageHeaderV2
+            int page = id, subId = 0, subType;
+            while (reader.field(subId, subType))
+            {
+                if (subId == 1 && subType == THRIFT_I32)
+                    header.numValues = reader.integer();
+                else if (subId == 2 && subType == THRIFT_I32 && page != 8)
+                    header.encoding = reader.integer();
+                else if (subId == 4 && subType == THRIFT_I32 && page == 8)
+                    header.encoding = reader.integer();
+                else if (subId == 5 && subType == THRIFT_I32 && page == 8)
+                    header.definitionLevelsLength = reader.integer();
+                else if (subId == 6 && subType == THRIFT_I32 && page == 8)
+                    header.repetitionLevelsLength = reader.integer();
+                else if (subId == 7 && page == 8 && (subType == THRIFT_TRUE || subType == THRIFT_FALSE))
+                    header.isCompressed = reader.boolean(subType);
+                else
+                    reader.skip(subType);
+            }
+        }
+        else
+            reader.skip(type);
+    }
+    return header;
+}
+
+// Decompress a Snappy block into out
+static void snappyDecompress(const char *src, size_t length, size_t expected, string &out)
+{
+    const uint8_t *p = (const uint8_t *)src;
+    const uint8_t *end = p + length;
+    auto next = [&]() -> uint32_t
+    {
+        if (p >= end)
+            corrupt("truncated Snappy data");
+        return *p++;
+    };
+
+    uint64_t size = 0;
+    for (int shift = 0;; shift += 7)
+    {
+        uint32_t b = next();
+        size |= (uint64_t)(b & 0x7F) << shift;
+        if (!(b & 0x80))
+            break;
+        if (shift > 28)
+            corrupt("bad Snappy length");
+    }
+    if (size != expected)
+        corrupt("Snappy length does not match the page header");
+
+    out.resize(size);
+    char *dst = &out[0];
+    size_t written = 0;
+    while (p < end)
+    {
+        uint32_t tag = next();
+        size_t copyLength, offset;
+        if ((tag & 3) == 0)
+        {
+            size_t literal = (tag >> 2) + 1;
+            if (literal > 60)
+            {
+                int bytes = literal - 60;
+                literal = 0;
+                for (int i = 0; i < bytes; ++i)
+                    literal |= (size_t)next() << (8 * i);
+                literal += 1;
+            }
+            if (literal > (size_t)(end - p) || written + literal > size)
+                corrupt("Snappy literal out of range");
+            memcpy(dst + written, p, literal);
+            p += literal;
+            written += literal;
+            continue;
+        }
+        if ((tag & 3) == 1)
+        {
+            copyLength = ((tag >> 2) & 7) + 4;
+            offset = ((tag >> 5) << 8) | next();
+        }
+        else if ((tag & 3) == 2)
+        {
+            copyLength = (tag >> 2) + 1;
+            offset = next();
+            offset |= next() << 8;
+        }
+        else
+        {
+            copyLength = (tag >> 2) + 1;
+            offset = 0;
+            for (int i = 0; i < 4; ++i)
+                offset |= (size_t)next() << (8 * i);
+        }
+        if (offset == 0 || offset > written || written + copyLength > size)
+            corrupt("Snappy copy out of range");
+        // Copies may overlap their own output, so go byte by byte
+        for (size_t i = 0; i < copyLength; ++i, ++written)
+            dst[written] = dst[written - offset];
+    }
+    if (written != size)
+        corrupt("truncated Snappy data");
+}
+
+// Inflate a gzip page into out
+static void gzipDecompress(const char *src, size_t length, size_t expected, string &out)
+{
+    out.resize(expected);
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    if (inflateInit2(&stream, 15 + 16) != Z_OK)
+        throw runtime_error("Could not start gzip decompression");
+    stream.next_in = (Bytef *)src;
+    stream.avail_in = length;
+    stream.next_out = (Bytef *)&out[0];
+    stream.avail_out = expected;
+    int result = inflate(&stream, Z_FINISH);
+    inflateEnd(&stream);
+    if (result != Z_STREAM_END || stream.avail_out != 0)
+        corrupt("bad gzip page");
+}
+
+// Bytes of a page body after decompression; scratch holds them if they had to be expanded
+static const char *pageBytes(int codec, const char *src, int64_t length, int64_t uncompressed, string &scratch)
+{
+    if (length < 0 || uncompressed < 0)
+        corrupt("bad page size");
+    if (codec == CODEC_UNCOMPRESSED)
+    {
+        // Read in place, so the page must hold exactly the bytes it claims
+        if (uncompressed != length)
+            corrupt("uncompressed page size does not match its body");
+        return src;
+    }
+    if (codec == CODEC_SNAPPY)
+    {
+        snappyDecompress(src, length, uncompressed, scratch);
+        return scratch.data();
+    }
+    if (codec == CODEC_GZIP)
+    {
+        gzipDecompress(src, length, uncompressed, scratch);
+        return scratch.data();
+    }
+    throw runtime_error("Parquet compression codec " + to_string(codec) + " is not supported; use Snappy, gzip or none");
+}
+
+// Decode count values of the RLE / bit-packed hybrid encoding into out
+static void decodeHybrid(const char *p, const char *end, int bitWidth, size_t count, vector<uint32_t> &out)
+{
+    out.clear();
+    out.reserve(count);
+    int byteWidth = (bitWidth + 7) / 8;
+    uint32_t mask = bitWidth == 32 ? 0xFFFFFFFF : (1u << bitWidth) - 1;
+    while (out.size() < count)
+    {
+        uint64_t header = 0;
+        for (int shift = 0;; shift += 7)
+        {
+            if (p >= end)
+                corrupt("truncated levels or indices");
+            uint8_t b = *p++;
+            header |= (uint64_t)(b & 0x7F) << shift;
+            if (!(b & 0x80))
+                break;
+        }
+        if (header & 1)
+        {
+            // Bit-packed groups of 8 values, least significant bit first
+            size_t values = (header >> 1) * 8;
+            size_t bytes = (header >> 1) * bitWidth;
+            if (bytes > (size_t)(end - p))
+                corrupt("truncated bit-packed run");
+            uint64_t bits = 0;
+            int available = 0;
+            const uint8_t *q = (const uint8_t *)p;
+            for (size_t i = 0; i < values && out.size() < count; ++i)
+            {
+                while (available < bitWidth)
+                {
+                    bits |= (uint64_t)*q++ << available;
+                    available += 8;
+                }
+                out.push_back(bits & mask);
+                bits >>= bitWidth;
+                available -= bitWidth;
+            }
+            p += bytes;
+        }
+        else
+        {
+            size_t run = header >> 1;
+            if (byteWidth > end - p)
+                corrupt("truncated RLE run");
+            uint32_t value = 0;
+            for (int i = 0; i < byteWidth; ++i)
+                value |= (uint32_t)(uint8_t)p[i] << (8 * i);
+            p += byteWidth;
+            for (size_t i = 0; i < run && out.size() < count; ++i)
+                out.push_back(value);
+        }
+    }
+}
+
+// Decode count PLAIN values from p into numbers or strings
+static const char *decodePlain(const char *p, const char *end, int type, size_t count, vector<double> &numbers, vector<string> &strings)
+{
+    auto need = [&](size_t bytes)
+    {
+        if (bytes > (size_t)(end - p))
+            corrupt("truncated values");
+    };
+    switch (type)
+    {
+    case TYPE_BOOLEAN:
+        need((count + 7) / 8);
+        for (size_t i = 0; i < count; ++i)
+            numbers.push_back((p[i / 8] >> (i % 8)) & 1);
+        return p + (count + 7) / 8;
+    case TYPE_INT32:
+        need(4 * count);
+        for (size_t i = 0; i < count; ++i, p += 4)
+        {
+            int32_t value;
+            memcpy(&value, p, 4);
+            numbers.push_back(value);
+        }
+        return p;
+    case TYPE_INT64:
+        need(8 * count);
+        for (size_t i = 0; i < count; ++i, p += 8)
+        {
+            int64_t value;
+            memcpy(&value, p, 8);
+            numbers.push_back(value);
+        }
+        return p;
+    case TYPE_FLOAT:
+        need(4 * count);
+        for (size_t i = 0; i < count; ++i, p += 4)
+        {
+            float value;
+            memcpy(&value, p, 4);
+            numbers.push_back(value);
+        }
+        return p;
+    case TYPE_DOUBLE:
+        need(8 * count);
+        for (size_t i = 0; i < count; ++i, p += 8)
+        {
+            double value;
+            memcpy(&value, p, 8);
+            numbers.push_back(value);
+        }
+        return p;
+    default:
+        for (size_t i = 0; i < count; ++i)
+        {
+            need(4);
+            uint32_t length;
+            memcpy(&length, p, 4);
+            p += 4;
+            need(length);
+            strings.emplace_back(p, length);
+            p += length;
+        }
+        return p;
+    }
+}
+
+ParquetReader::ParquetReader(const string &data)
+    : data(data)
+{
+    readFooter();
+}
+
+// Schema and column chunk locations from the FileMetaData at the end of the file
+void ParquetReader::readFooter()
+{
+    if (data.size() < 12 || data.compare(0, 4, PARQUET_MAGIC) != 0 || data.compare(data.size() - 4, 4, PARQUET_MAGIC) != 0)
+        throw runtime_error("Not a Parquet file");
+    uint32_t footerLength;
+    memcpy(&footerLength, data.data() + data.size() - 8, 4);
+    if ((uint64_t)footerLength + 12 > data.size())
+        corrupt("footer out of range");
+
+    ThriftReader reader{data, data.size() - 8 - footerLength};
+    int id = 0, type, elementType;
+    while (reader.field(id, type))
+    {
+        if (id == 2 && type == THRIFT_LIST)
+        {
+            // SchemaElement list: the root first, then its children depth-first
+            uint64_t count = reader.list(elementType);
+            for (uint64_t i = 0; i < count; ++i)
+            {
+                Column column = {"", -1, false};
+                int children = 0, repetition = 0;
+                int subId = 0, subType;
+                while (reader.field(subId, subType))
+                {
+                    if (subId == 1 && subType == THRIFT_I32)
+                        column.type = reader.integer();
+                    else if (subId == 3 && subType == THRIFT_I32)
+                        repetition = reader.integer();
+                    else if (subId == 4 && subType == THRIFT_BINARY)
+                        column.name = reader.binary();
+                    else if (subId == 5 && subType == THRIFT_I32)
+                        children = reader.integer();
+                    else
+                        reader.skip(subType);
+                }
+                if (i == 0)
+                    continue;
+                if (children > 0 || repetition == REPETITION_REPEATED)
+                    throw runtime_error("Column \"" + column.name + "\" is nested or repeated; only flat Parquet tables can be read");
+                column.optional = repetition == REPETITION_OPTIONAL;
+                schemaColumns.push_back(column);
+            }
+        }
+        else if (id == 4 && type == THRIFT_LIST)
+        {
+            uint64_t groups = reader.list(elementType);
+            for (uint64_t g = 0; g < groups; ++g)
+            {
+                vector<Chunk> chunks;
+                int groupId = 0, groupType;
+                while (reader.field(groupId, groupType))
+                {
+                    if (groupId != 1 || groupType != THRIFT_LIST)
+                    {
+                        reader.skip(groupType);
+                        continue;
+                    }
+                    uint64_t count = reader.list(elementType);
+                    for (uint64_t c = 0; c < count; ++c)
+                    {
+                        Chunk chunk = {CODEC_UNCOMPRESSED, 0, 0, 0};
+                        int64_t dataPage = -1, dictionaryPage = -1;
+                        int chunkId = 0, chunkType;
+                        while (reader.field(chunkId, chunkType))
+                        {
+                            if (chunkId != 3 || chunkType != THRIFT_STRUCT)
+                            {
+                                reader.skip(chunkType);
+                                continue;
+                            }
+                            // ColumnMetaData
+                            int metaId = 0, metaType;
+                            while (reader.field(metaId, metaType))
+                            {
+                                if (metaId == 4 && metaType == THRIFT_I32)
+                                    chunk.codec = reader.integer();
+                                else if (metaId == 5 && metaType == THRIFT_I64)
+                                    chunk.numValues = reader.integer();
+                                else if (metaId == 7 && metaType == THRIFT_I64)
+                                    chunk.length = reader.integer();
+                                else if (metaId == 9 && metaType == THRIFT_I64)
+                                    dataPage = reader.integer();
+                                else if (metaId == 11 && metaType == THRIFT_I64)
+                                    dictionaryPage = reader.integer();
+                                else
+                                    reader.skip(metaType);
+                            }
+                        }
+                        // Some writers set the dictionary page offset to 0 when there is none
+                        chunk.start = dictionaryPage > 0 && dictionaryPage < dataPage ? dictionaryPage : dataPage;
+                        if (dataPage < 0 || chunk.start > data.size() || chunk.length > data.size() - chunk.start)
+                            corrupt("column chunk out of range");
+                        chunks.push_back(chunk);
+                    }
+                }
+                rowGroups.push_back(chunks);
+            }
+        }
+        else
+            reader.skip(type);
+    }
+
+    for (const auto &chunks : rowGroups)
+    {
+        if (chunks.size() != schemaColumns.size())
+            corrupt("row group does not match the schema");
+    }
+}
+
+// Append the values of one column chunk, page by page
+void ParquetReader::readChunk(const Chunk &chunk, const Column &column, RosterColumn &out)
+{
+    vector<double> numberDictionary, numbers;
+    vector<string> stringDictionary, strings;
+    vector<uint32_t> levels, indices;
+    string scratch;
+    bool text = column.type == TYPE_BYTE_ARRAY;
+
+    uint64_t pos = chunk.start;
+    uint64_t end = chunk.start + chunk.length;
+    int64_t valuesRead = 0;
+    while (valuesRead < chunk.numValues)
+    {
+        if (pos >= end)
+            corrupt("column chunk ends before its values");
+        ThriftReader reader{data, pos};
+        PageHeader header = readPageHeader(reader);
+        const char *body = data.data() + reader.pos;
+        if (header.compressedSize < 0 || reader.pos > end || (uint64_t)header.compressedSize > end - reader.pos)
+            corrupt("page out of range");
+        pos = reader.pos + header.compressedSize;
+
+        if (header.type == PAGE_DICTIONARY)
+        {
+            const char *bytes = pageBytes(chunk.codec, body, header.compressedSize, header.uncompressedSize, scratch);
+            numberDictionary.clear();
+            stringDictionary.clear();
+            decodePlain(bytes, bytes + header.uncompressedSize, column.type, header.numValues, numberDictionary, stringDictionary);
+            continue;
+        }
+        if (header.type != PAGE_DATA && header.type != PAGE_DATA_V2)
+            continue;
+
+        // Definition levels, then the values of the rows that are not null
+        const char *values, *valuesEnd;
+        size_t count = header.numValues;
+        if (header.type == PAGE_DATA)
+        {
+            const char *bytes = pageBytes(chunk.codec, body, header.compressedSize, header.uncompressedSize, scratch);
+            values = bytes;
+            valuesEnd = bytes + header.uncompressedSize;
+            if (column.optional)
+            {
+                uint32_t length;
+                if (valuesEnd - values < 4)
+                    corrupt("truncated definition levels");
+                memcpy(&length, values, 4);
+                if (length > (size_t)(valuesEnd - values - 4))
+                    corrupt("truncated definition levels");
+                decodeHybrid(values + 4, values + 4 + length, 1, count, levels);
+                values += 4 + length;
+            }
+        }
+        else
+        {
+            if (header.definitionLevelsLength < 0 || header.repetitionLevelsLength < 0
+                || header.repetitionLevelsLength > header.compressedSize
+                || header.definitionLevelsLength > header.compressedSize - header.repetitionLevelsLength)
+                corrupt("levels out of range");
+            int64_t levelsLength = header.definitionLevelsLength + header.repetitionLevelsLength;
+            if (levelsLength > header.compressedSize || levelsLength > header.uncompressedSize)
+                corrupt("levels out of range");
+            if (column.optional)
+            {
+                const char *definition = body + header.repetitionLevelsLength;
+                decodeHybrid(definition, definition + header.definitionLevelsLength, 1, count, levels);
+            }
+            int codec = header.isCompressed ? chunk.codec : CODEC_UNCOMPRESSED;
+            values = pageBytes(codec, body + levelsLength, header.compressedSize - levelsLength, header.uncompressedSize - levelsLength, scratch);
+            valuesEnd = values + header.uncompressedSize - levelsLength;
+        }
+
+        size_t present = count;
+        if (column.optional)
+        {
+            present = 0;
+            for (uint32_t level : levels)
+                present += level;
+        }
+
+        // Pages without nulls decode straight into the column
+        bool direct = present == count;
+        vector<double> &pageNumbers = direct ? out.numbers : numbers;
+        vector<string> &pageStrings = direct ? out.strings : strings;
+        numbers.clear();
+        strings.clear();
+        if (header.encoding == ENCODING_PLAIN)
+        {
+            decodePlain(values, valuesEnd, column.type, present, pageNumbers, pageStrings);
+        }
+        else if (header.encoding == ENCODING_RLE && column.type == TYPE_BOOLEAN)
+        {
+            // Booleans as a length-prefixed run of 1-bit values (written with data page v2)
+            uint32_t length;
+            if (valuesEnd - values < 4)
+                corrupt("truncated boolean values");
+            memcpy(&length, values, 4);
+            if (length > (size_t)(valuesEnd - values - 4))
+                corrupt("truncated boolean values");
+            decodeHybrid(values + 4, values + 4 + length, 1, present, indices);
+            pageNumbers.insert(pageNumbers.end(), indices.begin(), indices.end());
+        }
+        else if (header.encoding == ENCODING_PLAIN_DICTIONARY || header.encoding == ENCODING_RLE_DICTIONARY)
+        {
+            if (values >= valuesEnd && present > 0)
+                corrupt("truncated dictionary indices");
+            int bitWidth = present > 0 ? (uint8_t)*values : 0;
+            if (bitWidth > 32)
+                corrupt("bad dictionary index width");
+            if (present > 0)
+                decodeHybrid(values + 1, valuesEnd, bitWidth, present, indices);
+            size_t dictionarySize = text ? stringDictionary.size() : numberDictionary.size();
+            for (size_t i = 0; i < present; ++i)
+            {
+                if (indices[i] >= dictionarySize)
+                    corrupt("dictionary index out of range");
+                if (text)
+                    pageStrings.push_back(stringDictionary[indices[i]]);
+                else
+                    pageNumbers.push_back(numberDictionary[indices[i]]);
+            }
+        }
+        else
+            throw runtime_error("Parquet encoding " + to_string(header.encoding) + " is not supported in column \"" + column.name + "\"");
+
+        // Nulls read as 0 or ""
+        size_t next = 0;
+        for (size_t i = 0; i < count && !direct; ++i)
+        {
+            bool valid = levels[i];
+            if (text)
+                out.strings.push_back(valid ? move(strings[next]) : string());
+            else
+                out.numbers.push_back(valid ? numbers[next] : 0.0);
+            next += valid;
+        }
+        valuesRead += count;
+    }
+}
+
+vector<string> ParquetReader::columnNames() const
+{
+    vector<string> names;
+    for (const auto &column : schemaColumns)
+    {
+        names.push_back(column.name);
+    }
+    return names;
+}
+
+vector<RosterColumn> ParquetReader::readColumns(const vector<int> &columns)
+{
+    vector<int> selected = columns;
+    if (selected.empty())
+    {
+        for (int i = 0; i < schemaColumns.size(); ++i)
+            selected.push_back(i);
+    }
+
+    vector<RosterColumn> result(selected.size());
+    for (size_t c = 0; c < selected.size(); ++c)
+    {
+        if (selected[c] < 0 || selected[c] >= schemaColumns.size())
+            throw out_of_range("Invalid column index " + to_string(selected[c]));
+        const Column &column = schemaColumns[selected[c]];
+        bool supported = column.type == TYPE_BOOLEAN || column.type == TYPE_INT32 || column.type == TYPE_INT64 ||
+                         column.type == TYPE_FLOAT || column.type == TYPE_DOUBLE || column.type == TYPE_BYTE_ARRAY;
+        if (!supported)
+            throw runtime_error("Column \"" + column.name + "\" has a Parquet type that is not supported");
+        result[c].name = column.name;
+        result[c].text = column.type == TYPE_BYTE_ARRAY;
+
+        int64_t numValues = 0;
+        for (const auto &chunks : rowGroups)
+            numValues += chunks[selected[c]].numValues;
+        if (result[c].text)
+            result[c].strings.reserve(numValues);
+        else
+            result[c].numbers.reserve(numValues);
+
+        for (const auto &chunks : rowGroups)
+        {
+            readChunk(chunks[selected[c]], column, result[c]);
+        }
+    }
+    return result;
+}
\ No newline at end of file
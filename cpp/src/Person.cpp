@@ -2,9 +2,9 @@
 using namespace std;
 
 // Class to represent a Person
-Person::Person(const string &n, double s) : name(n), score(s) {}
+Person::Person(const string &n, double s, int i) : name(n), score(s), index(i) {}
 
-string Person::getName() const
+const string &Person::getName() const
 {
     return name;
 }
@@ -14,6 +14,11 @@ double Person::getScore() const
     return score;
 }
 
+int Person::getIndex() const
+{
+    return index;
+}
+
 // Function to sort Persons by name
 bool sortByName(const Person &s1, const Person &s2)
 {
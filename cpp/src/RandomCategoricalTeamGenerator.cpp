@@ -1,26 +1,90 @@
 #include "../include/RandomCategoricalTeamGenerator.h"
 #include <random>
 #include <algorithm>
+#include <stdexcept>
+#include <cmath>
 using namespace std;
 
-vector<Team> RandomCategoricalTeamGenerator::createTeams(int numTeams)
+RandomCategoricalTeamGenerator::RandomCategoricalTeamGenerator() : gen(random_device()()) {}
+
+// The smallest teams first and, among teams of equal size, a fresh random priority every time
+// a team re-enters the heap, so the group goes to a uniformly random one of them
+pair<double, double> RandomCategoricalTeamGenerator::teamPriority(int size, double)
+{
+    return {(double)size, uniform_real_distribution<>(0.0, 1.0)(gen)};
+}
+
+vector<Team> RandomCategoricalTeamGenerator::createTeams(int numTeams, const TeamSizeBounds &bounds)
 {
-    // Sort Persons based on their scores in descending order
-    sort(Persons.begin(), Persons.end(), [](const Person &s1, const Person &s2)
-              { return s1.getScore() > s2.getScore(); });
+    sizeBounds = bounds;
+    if (!constraints.empty() || sizeBounds.isSet() || !diversityColumns.empty())
+    {
+        return assignGroups(numTeams);
+    }
+
+    // Sort key per Person: the score, plus with jitter a uniform offset of up to jitter
+    // standard deviations of the scores, so Persons near a tier boundary can change tiers
+    vector<double> keys(Persons.size());
+    double sum = 0.0, sumSquares = 0.0;
+    for (int i = 0; i < Persons.size(); ++i)
+    {
+        keys[i] = Persons[i].getScore();
+        sum += keys[i];
+        sumSquares += keys[i] * keys[i];
+    }
+    if (jitter > 0 && !Persons.empty())
+    {
+        double mean = sum / Persons.size();
+        double stddev = sqrt(max(0.0, sumSquares / Persons.size() - mean * mean));
+        uniform_real_distribution<> offset(-jitter * stddev, jitter * stddev);
+        for (double &key : keys)
+        {
+            key += offset(gen);
+        }
+    }
+
+    // Sort Persons by key in descending order, keeping them aligned with the roster
+    vector<int> order(Persons.size());
+    for (int i = 0; i < order.size(); ++i)
+    {
+        order[i] = i;
+    }
+    stable_sort(order.begin(), order.end(), [&](int a, int b)
+                { return keys[a] > keys[b]; });
 
     teams.clear();
     teams.resize(numTeams);
 
-    // Assign each Person to a random team in the order of their scores
-    random_device rd;
-    mt19937 gen(rd());
-    for (const auto &Person : Persons)
+    // Split the order into tiers of numTeams Persons and give every team one Person of each
+    // tier through a fresh random permutation of the teams, so sizes differ by at most one
+    // and every team draws from every score band
+    vector<int> permutation(numTeams);
+    for (int team = 0; team < numTeams; ++team)
+    {
+        permutation[team] = team;
+    }
+    for (int tierStart = 0; tierStart < order.size(); tierStart += numTeams)
     {
-        uniform_int_distribution<> dis(0, numTeams - 1);
-        int teamIndex = dis(gen);
-        teams[teamIndex].addPerson(Person);
+        shuffle(permutation.begin(), permutation.end(), gen);
+        int tierSize = min(numTeams, (int)order.size() - tierStart);
+        for (int i = 0; i < tierSize; ++i)
+        {
+            teams[permutation[i]].addPerson(Persons[order[tierStart + i]]);
+        }
     }
 
     return teams;
+}
+
+void RandomCategoricalTeamGenerator::setJitter(double jitter)
+{
+    this->jitter = jitter;
+}
+
+// Restart the random sequence from seed, so the same input gives the same teams; 0 keeps the
+// random seed
+void RandomCategoricalTeamGenerator::setSeed(unsigned seed)
+{
+    if (seed != 0)
+        gen.seed(seed);
 }
\ No newline at end of file
@@ -1,41 +1,228 @@
 #include "../include/RandomTeamGenerator.h"
+#include "../include/TaskScheduler.h"
+#include "../include/ColumnarInput.h"
+#include "../include/LineReader.h"
 #include <fstream>
 #include <sstream>
+#include <cstring>
 #include <random>
+#include <algorithm>
+#include <stdexcept>
 using namespace std;
 
-void RandomTeamGenerator::readPersonsFromFile(const string &filename, const vector<int> &categoryIndices, const vector<double> &weight)
+// Smallest roster shuffled and split into teams in parallel, and the most parts it is cut into
+static const size_t PARALLEL_SHUFFLE_MIN = 1 << 20;
+static const int MAX_SHUFFLE_THREADS = 64;
+
+// Run work(0) .. work(parts - 1) as tasks of the shared scheduler
+static void runParallel(int parts, const function<void(int)> &work)
+{
+    TaskScheduler::instance().parallelFor(0, parts, work);
+}
+
+// Uniform random permutation of 0 .. n - 1. Small inputs get an in-place Fisher-Yates shuffle;
+// large ones are scattered into one random bucket per thread and every bucket is then
+// Fisher-Yates shuffled on its own thread, which is still uniform and keeps each thread on a
+// contiguous range.
+static vector<int> shuffledIndices(size_t n, int threads, mt19937 &gen)
 {
-    string line;
-    ifstream file(filename);
+    vector<int> order(n);
+    threads = max(1, min(threads, MAX_SHUFFLE_THREADS));
+    if (threads == 1 || n < PARALLEL_SHUFFLE_MIN)
+    {
+        for (size_t i = 0; i < n; ++i)
+            order[i] = i;
+        for (size_t i = n; i > 1; --i)
+        {
+            size_t j = uniform_int_distribution<size_t>(0, i - 1)(gen);
+            swap(order[i - 1], order[j]);
+        }
+        return order;
+    }
+
+    vector<unsigned> seeds(2 * threads);
+    for (auto &seed : seeds)
+        seed = gen();
+
+    // Pick a bucket for every index and count the bucket sizes per thread
+    vector<uint8_t> bucketOf(n);
+    vector<vector<size_t>> counts(threads, vector<size_t>(threads, 0));
+    auto pickBuckets = [&](int t)
+    {
+        mt19937 local(seeds[t]);
+        uniform_int_distribution<int> pickBucket(0, threads - 1);
+        for (size_t i = n * t / threads; i < n * (t + 1) / threads; ++i)
+        {
+            bucketOf[i] = pickBucket(local);
+            counts[t][bucketOf[i]]++;
+        }
+    };
+    runParallel(threads, pickBuckets);
+
+    // Bucket b starts after all smaller buckets; within it, thread t writes after threads < t
+    vector<size_t> bucketStart(threads + 1, 0);
+    vector<vector<size_t>> cursor(threads, vector<size_t>(threads));
+    for (int b = 0; b < threads; ++b)
+    {
+        size_t offset = bucketStart[b];
+        for (int t = 0; t < threads; ++t)
+        {
+            cursor[t][b] = offset;
+            offset += counts[t][b];
+        }
+        bucketStart[b + 1] = offset;
+    }
+
+    auto scatter = [&](int t)
+    {
+        for (size_t i = n * t / threads; i < n * (t + 1) / threads; ++i)
+        {
+            order[cursor[t][bucketOf[i]]++] = i;
+        }
+    };
+    runParallel(threads, scatter);
+
+    auto shuffleBucket = [&](int b)
+    {
+        mt19937 local(seeds[threads + b]);
+        for (size_t i = bucketStart[b + 1]; i > bucketStart[b] + 1; --i)
+        {
+            size_t j = uniform_int_distribution<size_t>(bucketStart[b], i - 1)(local);
+            swap(order[i - 1], order[j]);
+        }
+    };
+    runParallel(threads, shuffleBucket);
+    return order;
+}
+
+// Read only the names (first column): the file is loaded in one read and scanned for line ends
+// and the first comma, with no per-line stream or field splitting. Every line after the header
+// is a row, blank ones included, as in TeamGenerator, so row indices match its roster
+void RandomTeamGenerator::readPersonsFromFile(const string &filename, const vector<int> &, const vector<double> &)
+{
+    // Arrow IPC and Parquet files: only the name column is read
+    if (isColumnarFile(filename))
+    {
+        RosterColumn names = readColumnarFile(filename, {0})[0];
+        size_t numRows = names.text ? names.strings.size() : names.numbers.size();
+        Persons.clear();
+        Persons.reserve(numRows);
+        for (size_t row = 0; row < numRows; ++row)
+        {
+            if (names.text)
+                Persons.push_back(Person(names.strings[row], 0.0, Persons.size()));
+            else
+            {
+                ostringstream ss;
+                ss << names.numbers[row];
+                Persons.push_back(Person(ss.str(), 0.0, Persons.size()));
+            }
+        }
+        return;
+    }
+
+    // Gzip-compressed files: names are cut from each line while the next blocks inflate
+    if (isGzipFile(filename))
+    {
+        LineReader reader(filename);
+        string line;
+        Persons.clear();
+        reader.getline(line); // Skip the header line
+        while (reader.getline(line))
+        {
+            size_t nameEnd = min(line.find(','), line.size());
+            if (nameEnd > 0 && line[nameEnd - 1] == '\r')
+                --nameEnd;
+            Persons.push_back(Person(line.substr(0, nameEnd), 0.0, Persons.size()));
+        }
+        return;
+    }
+
+    ifstream file(filename, ios::binary);
+    if (!file.is_open())
+    {
+        throw runtime_error("Unable to open file \"" + filename + "\"");
+    }
+    file.seekg(0, ios::end);
+    string buffer(file.tellg(), '\0');
+    file.seekg(0, ios::beg);
+    file.read(&buffer[0], buffer.size());
+
+    Persons.clear(); // Clear the existing Persons
+    Persons.reserve(count(buffer.begin(), buffer.end(), '\n'));
+    const char *pos = buffer.data();
+    const char *end = pos + buffer.size();
 
     // Skip the header line
-    getline(file, line);
+    const char *headerEnd = (const char *)memchr(pos, '\n', end - pos);
+    pos = headerEnd ? headerEnd + 1 : end;
 
     // Process the data lines
-    Persons.clear(); // Clear the existing Persons
-    while (getline(file, line))
+    while (pos < end)
     {
-        istringstream ss(line);
-        string name;
-        getline(ss, name, ',');
-        Persons.push_back(Person(name, 0.0)); // Scores are not used for random teams
+        const char *lineEnd = (const char *)memchr(pos, '\n', end - pos);
+        if (!lineEnd)
+            lineEnd = end;
+        const char *nameEnd = (const char *)memchr(pos, ',', lineEnd - pos);
+        if (!nameEnd)
+            nameEnd = lineEnd;
+        if (nameEnd > pos && nameEnd[-1] == '\r')
+            --nameEnd;
+        Persons.push_back(Person(string(pos, nameEnd), 0.0, Persons.size())); // Scores are not used for random teams
+        pos = lineEnd + 1;
     }
 }
 
-vector<Team> RandomTeamGenerator::createRandomTeams(int numTeams)
+// Use numPersons unnamed Persons instead of a file; teams then refer to them by index only
+void RandomTeamGenerator::setNumPersons(int numPersons)
+{
+    Persons.clear();
+    Persons.reserve(numPersons);
+    for (int row = 0; row < numPersons; ++row)
+    {
+        Persons.push_back(Person("", 0.0, row));
+    }
+}
+
+// Draw the same teams for the same roster, seed and thread count, unless seed is 0
+void RandomTeamGenerator::setSeed(unsigned seed)
+{
+    this->seed = seed;
+}
+
+// Shuffle the Persons and cut the shuffled order into consecutive slices, one per team, of
+// the sizes allowed by bounds (as even as possible by default)
+vector<Team> RandomTeamGenerator::createRandomTeams(int numTeams, const TeamSizeBounds &bounds, int threads)
 {
     random_device rd;
-    mt19937 gen(rd());
+    mt19937 gen(seed ? seed : rd());
 
-    vector<Team> teams(numTeams);
-    int PersonIndex = 0;
-    for (const auto &Person : Persons)
+    vector<int> sizes = bounds.targetSizes(numTeams, Persons.size());
+    vector<int> order = shuffledIndices(Persons.size(), threads, gen);
+
+    vector<size_t> start(numTeams + 1, 0);
+    for (int team = 0; team < numTeams; ++team)
     {
-        int teamIndex = PersonIndex % numTeams;
-        teams[teamIndex].addPerson(Person);
-        PersonIndex++;
+        start[team + 1] = start[team] + sizes[team];
     }
 
+    // Move the Persons into their teams (so this generator is spent afterwards); the gather is
+    // bound by memory latency, so large rosters split the teams between threads
+    vector<Team> teams(numTeams);
+    auto fillTeams = [&](int t, int parts)
+    {
+        for (int team = numTeams * t / parts; team < numTeams * (t + 1) / parts; ++team)
+        {
+            teams[team].reserve(sizes[team]);
+            for (size_t i = start[team]; i < start[team + 1]; ++i)
+            {
+                teams[team].addPerson(move(Persons[order[i]]));
+            }
+        }
+    };
+    int parts = Persons.size() < PARALLEL_SHUFFLE_MIN ? 1 : max(1, min(threads, MAX_SHUFFLE_THREADS));
+    runParallel(parts, [&](int t)
+                { fillTeams(t, parts); });
+    Persons.clear();
     return teams;
 }
\ No newline at end of file
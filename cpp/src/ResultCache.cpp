@@ -0,0 +1,322 @@
+#include "../include/ResultCache.h"
+#include <fstream>
+#include <sstream>
+#include <random>
+#include <cstdio>
+#include <cstdint>
+#include <algorithm>
+#include <filesystem>
+#include <sys/stat.h>
+using namespace std;
+
+// Version of the key layout and of the entry files; bump it when either changes
+static const uint32_t RESULT_CACHE_VERSION = 2;
+
+// Identity of a file's current contents without reading it: device, inode, size and
+// modification time. Empty if the file cannot be found.
+static string fileFingerprint(const string &filename)
+{
+    struct stat info;
+    if (stat(filename.c_str(), &info) != 0)
+        return "";
+    ostringstream ss;
+    ss << info.st_dev << ":" << info.st_ino << ":" << info.st_size << ":";
+#ifdef _WIN32
+    ss << info.st_mtime;
+#else
+    ss << info.st_mtim.tv_sec << "." << info.st_mtim.tv_nsec;
+#endif
+    return ss.str();
+}
+
+ResultCache::ResultCache(size_t maxBytes, const string &directory)
+    : maxBytes(maxBytes), directory(directory)
+{
+}
+
+// Key of a request, or an empty string if its teams may differ between runs (or its files
+// cannot be found) and it must not be cached
+string ResultCache::requestKey(const string &generationType, const StrategyRequest &request, const map<string, string> &options)
+{
+    unique_ptr<AssignmentStrategy> strategy = StrategyRegistry::instance().create(generationType);
+    if (!strategy)
+        return "";
+    StrategyInfo info = strategy->info();
+    auto reads = [&](const string &parameter)
+    {
+        return find(info.parameters.begin(), info.parameters.end(), parameter) != info.parameters.end();
+    };
+    if (!info.deterministic && !(request.seed != 0 && reads("seed")))
+        return "";
+
+    string roster = fileFingerprint(request.filename);
+    if (roster.empty())
+        return "";
+    ostringstream key;
+    key.precision(17);
+    key << "v" << RESULT_CACHE_VERSION << "|" << generationType << "|roster=" << roster << "|teams=" << request.numTeams << "|categories=";
+    for (size_t i = 0; i < request.categoryIndices.size() && i < request.weights.size(); ++i)
+        key << request.categoryIndices[i] << ":" << request.weights[i] << ",";
+
+    // Only the options the strategy reads, from their parsed values. Constraints are keyed by
+    // their content, as callers may write the same constraints to a new file per request.
+    if (reads("constraints") && !request.constraints.empty())
+        key << "|constraints=" << request.constraints.canonical();
+    if (reads("min-size"))
+        key << "|min-size=" << request.bounds.minSize;
+    if (reads("max-size"))
+        key << "|max-size=" << request.bounds.maxSize;
+    if (reads("capacities"))
+    {
+        key << "|capacities=";
+        for (int capacity : request.bounds.capacities)
+            key << capacity << ",";
+    }
+    if (reads("diversity"))
+    {
+        key << "|diversity=";
+        for (int column : request.diversityColumns)
+            key << column << ",";
+    }
+    if (reads("threads"))
+        key << "|threads=" << request.threads;
+    if (reads("deadline-ms"))
+        key << "|deadline-ms=" << request.deadlineMs;
+    if (reads("iterations"))
+        key << "|iterations=" << request.iterations;
+    if (reads("jitter"))
+        key << "|jitter=" << request.jitter;
+    if (reads("seed"))
+        key << "|seed=" << request.seed;
+    return key.str();
+}
+
+// Change the byte budget and the directory, evicting entries that no longer fit
+void ResultCache::configure(size_t maxBytes, const string &directory)
+{
+    lock_guard<mutex> lock(cacheMutex);
+    this->maxBytes = maxBytes;
+    this->directory = directory;
+    while (usedBytes > maxBytes && !entries.empty())
+    {
+        usedBytes -= entries.back().bytes;
+        index.erase(entries.back().key);
+        entries.pop_back();
+    }
+}
+
+// Entry file of a key: the 64-bit FNV-1a hash of the key in hex
+string ResultCache::pathOf(const string &key) const
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (unsigned char c : key)
+    {
+        hash ^= c;
+        hash *= 0x100000001b3ULL;
+    }
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.tmc", (unsigned long long)hash);
+    return directory + "/" + name;
+}
+
+// Entry file layout (native byte order): magic "TMRC", version, key length and key, team
+// count, then per team its member count and per member the row index, score, name length
+// and name
+bool ResultCache::load(const string &key, vector<Team> &teams) const
+{
+    ifstream file(pathOf(key), ios::binary | ios::ate);
+    if (!file.is_open())
+        return false;
+    uint32_t fileSize = min<streamoff>(file.tellg(), UINT32_MAX);
+    file.seekg(0);
+    // Lengths and counts beyond the file size mean a damaged file
+    auto readU32 = [&]()
+    {
+        uint32_t value = 0;
+        file.read((char *)&value, sizeof(value));
+        if (value > fileSize)
+            file.setstate(ios::failbit);
+        return file ? value : 0;
+    };
+
+    char magic[4] = {0, 0, 0, 0};
+    file.read(magic, 4);
+    if (string(magic, 4) != "TMRC" || readU32() != RESULT_CACHE_VERSION)
+        return false;
+    string storedKey(readU32(), '\0');
+    file.read(&storedKey[0], storedKey.size());
+    if (!file || storedKey != key)
+        return false; // a hash collision or a damaged file
+
+    vector<Team> loaded(readU32());
+    for (Team &team : loaded)
+    {
+        uint32_t numMembers = readU32();
+        if (!file)
+            return false;
+        team.reserve(numMembers);
+        for (uint32_t i = 0; i < numMembers; ++i)
+        {
+            int32_t row = 0;
+            double score = 0.0;
+            file.read((char *)&row, sizeof(row));
+            file.read((char *)&score, sizeof(score));
+            string name(readU32(), '\0');
+            file.read(&name[0], name.size());
+            if (!file)
+                return false;
+            team.addPerson(Person(name, score, row));
+        }
+    }
+    teams = move(loaded);
+
+    // Entry files are pruned oldest first, so mark this one as recently used
+    error_code ignored;
+    filesystem::last_write_time(pathOf(key), filesystem::file_time_type::clock::now(), ignored);
+    return true;
+}
+
+// Write an entry file next to its final name and rename it into place, so readers never see
+// a partial file. The cache is an optimization: failures are ignored.
+void ResultCache::save(const string &key, const vector<Team> &teams) const
+{
+    string path = pathOf(key);
+    string temporary = path + "." + to_string(random_device()()) + ".tmp";
+    {
+        ofstream file(temporary, ios::binary);
+        if (!file.is_open())
+            return;
+        auto writeU32 = [&](uint32_t value)
+        {
+            file.write((const char *)&value, sizeof(value));
+        };
+        file.write("TMRC", 4);
+        writeU32(RESULT_CACHE_VERSION);
+        writeU32(key.size());
+        file.write(key.data(), key.size());
+        writeU32(teams.size());
+        for (const Team &team : teams)
+        {
+            writeU32(team.getmembers().size());
+            for (const Person &person : team.getmembers())
+            {
+                int32_t row = person.getIndex();
+                double score = person.getScore();
+                string name = person.getName();
+                file.write((const char *)&row, sizeof(row));
+                file.write((const char *)&score, sizeof(score));
+                writeU32(name.size());
+                file.write(name.data(), name.size());
+            }
+        }
+        if (!file)
+        {
+            file.close();
+            remove(temporary.c_str());
+            return;
+        }
+    }
+    if (rename(temporary.c_str(), path.c_str()) != 0)
+        remove(temporary.c_str());
+    prune();
+}
+
+// Remove the least recently used entry files until the directory fits in the byte budget
+void ResultCache::prune() const
+{
+    vector<pair<filesystem::file_time_type, filesystem::path>> files;
+    uintmax_t total = 0;
+    error_code error;
+    for (const auto &file : filesystem::directory_iterator(directory, error))
+    {
+        if (file.path().extension() != ".tmc")
+            continue;
+        uintmax_t size = file.file_size(error);
+        if (error)
+            continue;
+        total += size;
+        files.push_back({file.last_write_time(error), file.path()});
+    }
+    sort(files.begin(), files.end());
+    for (size_t i = 0; i < files.size() && total > maxBytes; ++i)
+    {
+        uintmax_t size = filesystem::file_size(files[i].second, error);
+        if (!error && filesystem::remove(files[i].second, error))
+            total -= size;
+    }
+}
+
+// Add an entry in front and evict from the back until the budget holds; cacheMutex must be held
+void ResultCache::insert(const string &key, shared_ptr<const vector<Team>> teams)
+{
+    size_t bytes = key.size() + sizeof(Entry);
+    for (const Team &team : *teams)
+    {
+        bytes += sizeof(Team);
+        for (const Person &person : team.getmembers())
+            bytes += sizeof(Person) + person.getName().size();
+    }
+
+    auto it = index.find(key);
+    if (it != index.end())
+    {
+        usedBytes -= it->second->bytes;
+        entries.erase(it->second);
+        index.erase(it);
+    }
+    if (bytes > maxBytes)
+        return;
+    entries.push_front({key, teams, bytes});
+    index[key] = entries.begin();
+    usedBytes += bytes;
+    while (usedBytes > maxBytes)
+    {
+        usedBytes -= entries.back().bytes;
+        index.erase(entries.back().key);
+        entries.pop_back();
+    }
+}
+
+// Teams stored for key, from memory or else from the directory; null on a miss. The teams are
+// shared with the cache, not copied.
+shared_ptr<const vector<Team>> ResultCache::lookup(const string &key)
+{
+    lock_guard<mutex> lock(cacheMutex);
+    auto it = index.find(key);
+    if (it != index.end())
+    {
+        entries.splice(entries.begin(), entries, it->second);
+        ++hits;
+        return it->second->teams;
+    }
+    vector<Team> teams;
+    if (!directory.empty() && load(key, teams))
+    {
+        shared_ptr<const vector<Team>> loaded = make_shared<const vector<Team>>(move(teams));
+        insert(key, loaded);
+        ++hits;
+        return loaded;
+    }
+    ++misses;
+    return nullptr;
+}
+
+void ResultCache::store(const string &key, const vector<Team> &teams)
+{
+    lock_guard<mutex> lock(cacheMutex);
+    insert(key, make_shared<const vector<Team>>(teams));
+    if (!directory.empty())
+        save(key, teams);
+}
+
+long ResultCache::getHits() const
+{
+    lock_guard<mutex> lock(cacheMutex);
+    return hits;
+}
+
+long ResultCache::getMisses() const
+{
+    lock_guard<mutex> lock(cacheMutex);
+    return misses;
+}
\ No newline at end of file
@@ -0,0 +1,168 @@
+#include "../include/Roster.h"
+#include <stdexcept>
+using namespace std;
+
+template <typename Score>
+void BasicRoster<Score>::reset(const vector<string> &categoryHeaders, const vector<bool> &categorical)
+{
+    int numCategories = categoryHeaders.size();
+    names.clear();
+    this->categoryHeaders = categoryHeaders;
+    this->categorical = categorical;
+    numericColumns.assign(numCategories, {});
+    codeColumns.assign(numCategories, {});
+    dictionaries.assign(numCategories, {});
+    codeLookup.assign(numCategories, {});
+}
+
+template <typename Score>
+void BasicRoster<Score>::addName(const string &name)
+{
+    names.push_back(name);
+}
+
+template <typename Score>
+void BasicRoster<Score>::addNumeric(int category, double value)
+{
+    numericColumns[category].push_back(Traits::encode(value));
+}
+
+// Take a whole column of names or numeric values at once, e.g. from a columnar file
+template <typename Score>
+void BasicRoster<Score>::setNames(vector<string> &&columnNames)
+{
+    names = move(columnNames);
+}
+
+template <typename Score>
+void BasicRoster<Score>::setNumeric(int category, vector<double> &&values)
+{
+    vector<Stored> &column = numericColumns[category];
+    column.resize(values.size());
+    for (size_t person = 0; person < values.size(); ++person)
+        column[person] = Traits::encode(values[person]);
+    values.clear();
+}
+
+template <>
+void BasicRoster<double>::setNumeric(int category, vector<double> &&values)
+{
+    numericColumns[category] = move(values);
+}
+
+// Append a categorical value, giving every distinct value the next free code
+template <typename Score>
+void BasicRoster<Score>::addCategory(int category, const string &value)
+{
+    auto it = codeLookup[category].find(value);
+    if (it == codeLookup[category].end())
+    {
+        if (dictionaries[category].size() > UINT16_MAX)
+        {
+            throw runtime_error("Too many distinct values in category \"" + categoryHeaders[category] + "\"");
+        }
+        it = codeLookup[category].emplace(value, (uint16_t)dictionaries[category].size()).first;
+        dictionaries[category].push_back(value);
+    }
+    codeColumns[category].push_back(it->second);
+}
+
+template <typename Score>
+int BasicRoster<Score>::size() const
+{
+    return names.size();
+}
+
+template <typename Score>
+int BasicRoster<Score>::numCategories() const
+{
+    return categoryHeaders.size();
+}
+
+template <typename Score>
+const string &BasicRoster<Score>::getName(int person) const
+{
+    return names[person];
+}
+
+template <typename Score>
+const string &BasicRoster<Score>::getHeader(int category) const
+{
+    return categoryHeaders[category];
+}
+
+template <typename Score>
+bool BasicRoster<Score>::isCategorical(int category) const
+{
+    return categorical[category];
+}
+
+template <typename Score>
+const vector<typename BasicRoster<Score>::Stored> &BasicRoster<Score>::numeric(int category) const
+{
+    return numericColumns[category];
+}
+
+template <typename Score>
+double BasicRoster<Score>::getNumeric(int category, int person) const
+{
+    return Traits::decode(numericColumns[category][person]);
+}
+
+// A numeric column as doubles: the column itself if it is stored as doubles, otherwise its
+// values decoded into buffer
+template <typename Score>
+const vector<double> &BasicRoster<Score>::numericValues(int category, vector<double> &buffer) const
+{
+    const vector<Stored> &column = numericColumns[category];
+    buffer.resize(column.size());
+    for (size_t person = 0; person < column.size(); ++person)
+        buffer[person] = Traits::decode(column[person]);
+    return buffer;
+}
+
+template <>
+const vector<double> &BasicRoster<double>::numericValues(int category, vector<double> &) const
+{
+    return numericColumns[category];
+}
+
+template <typename Score>
+const vector<uint16_t> &BasicRoster<Score>::codes(int category) const
+{
+    return codeColumns[category];
+}
+
+template <typename Score>
+const vector<string> &BasicRoster<Score>::dictionary(int category) const
+{
+    return dictionaries[category];
+}
+
+template class BasicRoster<double>;
+template class BasicRoster<FixedScore>;
+
+// True if the cell holds a plain decimal number (an empty cell counts as numeric)
+bool isNumericCell(const string &cell)
+{
+    size_t first = cell.find_first_not_of(" \t\r\n");
+    if (first == string::npos)
+        return true;
+    size_t last = cell.find_last_not_of(" \t\r\n");
+
+    bool digits = false;
+    bool decimalPoint = false;
+    for (size_t i = first; i <= last; ++i)
+    {
+        char c = cell[i];
+        if (c >= '0' && c <= '9')
+            digits = true;
+        else if (c == '.' && !decimalPoint)
+            decimalPoint = true;
+        else if ((c == '-' || c == '+') && i == first)
+            continue;
+        else
+            return false;
+    }
+    return digits;
+}
\ No newline at end of file
@@ -0,0 +1,107 @@
+#include "../include/SharedOutput.h"
+#include <cstring>
+#include <cerrno>
+#include <stdexcept>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+using namespace std;
+
+// Bytes collected before every write into the segment
+static const size_t SHARED_OUTPUT_BUFFER_BYTES = 1 << 16;
+
+static const uint32_t SHARED_OUTPUT_VERSION = 1;
+
+SharedOutput::SharedOutput(const string &segmentName)
+    : name(segmentName[0] == '/' ? segmentName : "/" + segmentName), buffer(SHARED_OUTPUT_BUFFER_BYTES)
+{
+#ifdef _WIN32
+    throw runtime_error("Shared-memory output is not supported on this platform");
+#else
+    if (name.size() < 2 || name.find('/', 1) != string::npos)
+        throw invalid_argument("Invalid shared-memory name \"" + segmentName + "\"");
+    fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0)
+        throw runtime_error("Could not create shared-memory segment \"" + name + "\": " + strerror(errno));
+
+    // Reserve the header; it is filled in by finish()
+    SharedOutputHeader header = {};
+    if (::write(fd, &header, sizeof(header)) != sizeof(header))
+    {
+        close(fd);
+        shm_unlink(name.c_str());
+        throw runtime_error("Could not write to shared-memory segment \"" + name + "\"");
+    }
+    setp(buffer.data(), buffer.data() + buffer.size());
+#endif
+}
+
+SharedOutput::~SharedOutput()
+{
+#ifndef _WIN32
+    if (fd >= 0)
+        close(fd);
+    if (!finished)
+        shm_unlink(name.c_str());
+#endif
+}
+
+// Write the buffered bytes into the segment
+void SharedOutput::flushBuffer()
+{
+#ifndef _WIN32
+    const char *data = pbase();
+    size_t length = pptr() - pbase();
+    while (length > 0)
+    {
+        ssize_t n = ::write(fd, data, length);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            throw runtime_error("Could not write to shared-memory segment \"" + name + "\": " + strerror(errno));
+        data += n;
+        length -= n;
+        written += n;
+    }
+    setp(buffer.data(), buffer.data() + buffer.size());
+#endif
+}
+
+int SharedOutput::overflow(int c)
+{
+    flushBuffer();
+    if (c != traits_type::eof())
+    {
+        *pptr() = c;
+        pbump(1);
+    }
+    return traits_type::not_eof(c);
+}
+
+int SharedOutput::sync()
+{
+    flushBuffer();
+    return 0;
+}
+
+// Flush the payload and mark the segment complete; returns the payload size
+uint64_t SharedOutput::finish()
+{
+#ifndef _WIN32
+    flushBuffer();
+    SharedOutputHeader header = {{'T', 'M', 'S', 'H'}, SHARED_OUTPUT_VERSION, sizeof(SharedOutputHeader), written, 1, 0};
+    if (pwrite(fd, &header, sizeof(header), 0) != sizeof(header))
+        throw runtime_error("Could not write to shared-memory segment \"" + name + "\"");
+    close(fd);
+    fd = -1;
+    finished = true;
+#endif
+    return written;
+}
+
+const string &SharedOutput::getName() const
+{
+    return name;
+}
\ No newline at end of file
@@ -0,0 +1,314 @@
+#include "../include/TaskScheduler.h"
+#include <algorithm>
+using namespace std;
+
+// Attempts to find a task before an idle worker goes to sleep, and tasks per thread that
+// parallelFor() cuts its range into so that stealing can even out uneven iterations
+static const int IDLE_SPINS = 64;
+static const int TASKS_PER_THREAD = 4;
+
+int TaskScheduler::configuredThreads = 0;
+
+// Worker index of the current thread, for the scheduler it works for
+static thread_local const TaskScheduler *workerOwner = nullptr;
+static thread_local int workerIndex = -1;
+
+TaskScheduler::TaskScheduler(int numThreads)
+    : numThreads(max(1, numThreads)), start(Clock::now())
+{
+    for (int i = 0; i < this->numThreads; ++i)
+    {
+        workers.emplace_back(new Worker());
+    }
+    for (int i = 0; i + 1 < this->numThreads; ++i)
+    {
+        threads.emplace_back(&TaskScheduler::workerLoop, this, i);
+    }
+}
+
+TaskScheduler::~TaskScheduler()
+{
+    {
+        lock_guard<mutex> guard(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto &worker : threads)
+    {
+        worker.join();
+    }
+}
+
+// The scheduler shared by the whole program
+TaskScheduler &TaskScheduler::instance()
+{
+    static TaskScheduler scheduler(configuredThreads > 0 ? configuredThreads : max(1u, thread::hardware_concurrency()));
+    return scheduler;
+}
+
+// Size of the shared scheduler; only takes effect before its first use
+void TaskScheduler::configure(int numThreads)
+{
+    configuredThreads = numThreads;
+}
+
+int TaskScheduler::size() const
+{
+    return numThreads;
+}
+
+// Deque of the current thread: its own for a worker, the injection deque for any other thread
+int TaskScheduler::currentWorker() const
+{
+    return workerOwner == this ? workerIndex : numThreads - 1;
+}
+
+// Take a task from the back of the own deque, or else steal one from the front of another
+bool TaskScheduler::take(int self, Task &task)
+{
+    if (queued.load() == 0)
+        return false;
+
+    {
+        Worker &own = *workers[self];
+        lock_guard<mutex> guard(own.lock);
+        if (!own.tasks.empty())
+        {
+            task = move(own.tasks.back());
+            own.tasks.pop_back();
+            --queued;
+            return true;
+        }
+    }
+    for (int i = 1; i < numThreads; ++i)
+    {
+        Worker &victim = *workers[(self + i) % numThreads];
+        lock_guard<mutex> guard(victim.lock);
+        if (!victim.tasks.empty())
+        {
+            task = move(victim.tasks.front());
+            victim.tasks.pop_front();
+            --queued;
+            workers[self]->stolen++;
+            return true;
+        }
+    }
+    return false;
+}
+
+void TaskScheduler::execute(int self, Task &task)
+{
+    Clock::time_point begin = Clock::now();
+    try
+    {
+        task();
+    }
+    catch (...)
+    {
+        // Tasks report their errors through their TaskGroup
+    }
+    Worker &worker = *workers[self];
+    worker.busyNs += chrono::duration_cast<chrono::nanoseconds>(Clock::now() - begin).count();
+    worker.executed++;
+}
+
+void TaskScheduler::workerLoop(int self)
+{
+    workerOwner = this;
+    workerIndex = self;
+    Task task;
+    while (!stopping)
+    {
+        bool found = false;
+        for (int spin = 0; spin < IDLE_SPINS && !found; ++spin)
+        {
+            found = take(self, task);
+            if (!found)
+                this_thread::yield();
+        }
+        if (found)
+        {
+            execute(self, task);
+            task = nullptr;
+            continue;
+        }
+
+        unique_lock<mutex> guard(sleepMutex);
+        ++sleeping;
+        wake.wait(guard, [&]()
+                  { return queued.load() > 0 || stopping.load(); });
+        --sleeping;
+    }
+}
+
+void TaskScheduler::submit(Task task)
+{
+    Worker &worker = *workers[currentWorker()];
+    ++queued;
+    {
+        lock_guard<mutex> guard(worker.lock);
+        worker.tasks.push_back(move(task));
+    }
+    if (sleeping.load() > 0)
+    {
+        // Taking the lock orders this wake-up after a worker's check of the queue
+        lock_guard<mutex> guard(sleepMutex);
+    }
+    wake.notify_one();
+}
+
+// Run a task on the current thread, counted as work of the thread's own deque
+void TaskScheduler::runHere(Task &task)
+{
+    execute(currentWorker(), task);
+}
+
+// Call body(i) for every i in [begin, end), in chunks spread over the workers
+void TaskScheduler::parallelFor(int begin, int end, const function<void(int)> &body)
+{
+    if (end <= begin)
+        return;
+    int count = end - begin;
+    int chunks = min(count, numThreads * TASKS_PER_THREAD);
+    if (chunks == 1)
+    {
+        for (int i = begin; i < end; ++i)
+            body(i);
+        return;
+    }
+
+    TaskGroup group(*this);
+    for (int chunk = 0; chunk < chunks; ++chunk)
+    {
+        int first = begin + (long)count * chunk / chunks;
+        int last = begin + (long)count * (chunk + 1) / chunks;
+        group.run([&body, first, last]()
+                  {
+                      for (int i = first; i < last; ++i)
+                          body(i);
+                  });
+    }
+    group.wait();
+}
+
+// Counters of every worker, then of the threads outside the pool
+vector<WorkerStats> TaskScheduler::stats() const
+{
+    vector<WorkerStats> result;
+    for (const auto &worker : workers)
+    {
+        result.push_back({worker->executed.load(), worker->stolen.load(), worker->busyNs.load() / 1e6});
+    }
+    return result;
+}
+
+void TaskScheduler::printStatsJson(ostream &os) const
+{
+    double uptimeMs = chrono::duration<double, milli>(Clock::now() - start).count();
+    vector<WorkerStats> counters = stats();
+    os << "{\"threads\":" << numThreads << ",\"uptime_ms\":" << uptimeMs << ",\"workers\":[";
+    for (size_t i = 0; i < counters.size(); ++i)
+    {
+        if (i > 0)
+            os << ",";
+        os << "{\"worker\":" << (i + 1 == counters.size() ? string("\"caller\"") : to_string(i))
+           << ",\"tasks\":" << counters[i].tasks
+           << ",\"steals\":" << counters[i].steals
+           << ",\"busy_ms\":" << counters[i].busyMs
+           << ",\"utilization\":" << (uptimeMs > 0 ? counters[i].busyMs / uptimeMs : 0.0) << "}";
+    }
+    os << "]}";
+}
+
+TaskGroup::TaskGroup(TaskScheduler &scheduler)
+    : scheduler(scheduler), state(make_shared<State>())
+{
+}
+
+TaskGroup::~TaskGroup()
+{
+    finish();
+}
+
+void TaskGroup::run(const TaskScheduler::Task &task)
+{
+    {
+        lock_guard<mutex> guard(state->lock);
+        state->pending.push_back(task);
+        state->remaining++;
+    }
+    state->changed.notify_all();
+    shared_ptr<State> shared = state;
+    scheduler.submit([shared]()
+                     { runNext(*shared, nullptr); });
+}
+
+// Run the next queued task of the group on the current thread, through the scheduler's counters
+// unless it is null (a stand-in task is already counted); false if none was queued
+bool TaskGroup::runNext(State &state, TaskScheduler *scheduler)
+{
+    TaskScheduler::Task task;
+    {
+        lock_guard<mutex> guard(state.lock);
+        if (state.pending.empty())
+            return false;
+        task = move(state.pending.front());
+        state.pending.pop_front();
+    }
+    exception_ptr failure;
+    TaskScheduler::Task guarded = [&]()
+    {
+        try
+        {
+            task();
+        }
+        catch (...)
+        {
+            failure = current_exception();
+        }
+    };
+    if (scheduler)
+        scheduler->runHere(guarded);
+    else
+        guarded();
+
+    bool done;
+    {
+        lock_guard<mutex> guard(state.lock);
+        if (failure && !state.error)
+            state.error = failure;
+        done = --state.remaining == 0;
+    }
+    if (done)
+        state.changed.notify_all();
+    return true;
+}
+
+// Run the group's queued tasks here and sleep while the others finish elsewhere
+void TaskGroup::finish()
+{
+    while (true)
+    {
+        if (runNext(*state, &scheduler))
+            continue;
+        unique_lock<mutex> guard(state->lock);
+        state->changed.wait(guard, [&]()
+                            { return state->remaining == 0 || !state->pending.empty(); });
+        if (state->remaining == 0)
+            return;
+    }
+}
+
+// Wait until every task of the group is done
+void TaskGroup::wait()
+{
+    finish();
+    exception_ptr first;
+    {
+        lock_guard<mutex> guard(state->lock);
+        first = state->error;
+        state->error = nullptr;
+    }
+    if (first)
+        rethrow_exception(first);
+}
\ No newline at end of file
@@ -3,7 +3,7 @@
 #include <iomanip>
 using namespace std;
 
-vector<Person> Team::getmembers() const // Added const here
+const vector<Person> &Team::getmembers() const // Added const here
 {
     return members;
 }
@@ -14,6 +14,16 @@ void Team::addPerson(const Person &Person)
     members.push_back(Person);
 }
 
+void Team::addPerson(Person &&Person)
+{
+    members.push_back(move(Person));
+}
+
+void Team::reserve(int size)
+{
+    members.reserve(size);
+}
+
 void Team::printTeamWithWeights() const
 {
     for (const auto &member : members)
@@ -0,0 +1,80 @@
+#include "../include/TeamAggregates.h"
+using namespace std;
+
+TeamAggregates::TeamAggregates(const vector<Team> &teams, const Roster &roster)
+{
+    int numTeams = teams.size();
+    teamOfPerson.assign(roster.size(), -1);
+    sizes.assign(numTeams, 0);
+    for (int team = 0; team < numTeams; ++team)
+    {
+        for (const auto &member : teams[team].getmembers())
+        {
+            teamOfPerson[member.getIndex()] = team;
+        }
+        sizes[team] = teams[team].getmembers().size();
+    }
+    accumulateTotals(roster);
+}
+
+// Aggregates of an index-based assignment: teamOfPerson[person] is a team or -1
+TeamAggregates::TeamAggregates(const vector<int> &teamOfPerson, int numTeams, const Roster &roster)
+    : teamOfPerson(teamOfPerson), sizes(numTeams, 0)
+{
+    for (int team : teamOfPerson)
+    {
+        if (team != -1)
+            sizes[team]++;
+    }
+    accumulateTotals(roster);
+}
+
+// One pass per category column, accumulating into that category's team totals in the roster's
+// total type (exact for fixed-point scores)
+void TeamAggregates::accumulateTotals(const Roster &roster)
+{
+    int numTeams = sizes.size();
+    totals.assign(roster.numCategories(), {});
+    vector<Roster::Total> sums;
+    for (int category = 0; category < roster.numCategories(); ++category)
+    {
+        if (roster.isCategorical(category))
+            continue;
+        const vector<Roster::Stored> &column = roster.numeric(category);
+        sums.assign(numTeams, 0);
+        for (int person = 0; person < column.size(); ++person)
+        {
+            if (teamOfPerson[person] != -1)
+                sums[teamOfPerson[person]] += column[person];
+        }
+        vector<double> &columnTotals = totals[category];
+        columnTotals.resize(numTeams);
+        for (int team = 0; team < numTeams; ++team)
+            columnTotals[team] = Roster::Traits::decodeTotal(sums[team]);
+    }
+}
+
+int TeamAggregates::getNumTeams() const
+{
+    return sizes.size();
+}
+
+int TeamAggregates::teamOf(int person) const
+{
+    return teamOfPerson[person];
+}
+
+const vector<int> &TeamAggregates::getTeamOfPerson() const
+{
+    return teamOfPerson;
+}
+
+const vector<int> &TeamAggregates::getSizes() const
+{
+    return sizes;
+}
+
+const vector<double> &TeamAggregates::getTotals(int category) const
+{
+    return totals[category];
+}
\ No newline at end of file
@@ -0,0 +1,349 @@
+#include "../include/TeamConstraints.h"
+#include <fstream>
+#include <sstream>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+using namespace std;
+
+// Trim surrounding whitespace from a constraint field
+static string trimField(const string &field)
+{
+    size_t first = field.find_first_not_of(" \t\r\n");
+    if (first == string::npos)
+        return "";
+    size_t last = field.find_last_not_of(" \t\r\n");
+    return field.substr(first, last - first + 1);
+}
+
+// Read constraints, one per line: "together,<name>,<name>,..." or "apart,<name>,<name>"
+void TeamConstraints::readFromFile(const string &filename)
+{
+    ifstream file(filename);
+    if (!file.is_open())
+    {
+        throw runtime_error("Unable to open constraints file \"" + filename + "\"");
+    }
+
+    string line;
+    while (getline(file, line))
+    {
+        istringstream ss(line);
+        string field;
+        vector<string> fields;
+        while (getline(ss, field, ','))
+        {
+            field = trimField(field);
+            if (!field.empty())
+                fields.push_back(field);
+        }
+        if (fields.empty() || fields[0][0] == '#')
+            continue;
+
+        string kind = fields[0];
+        fields.erase(fields.begin());
+        if (kind == "together")
+        {
+            addTogether(fields);
+        }
+        else if (kind == "apart" && fields.size() == 2)
+        {
+            addApart(fields[0], fields[1]);
+        }
+        else
+        {
+            throw runtime_error("Invalid constraint line: \"" + line + "\"");
+        }
+    }
+}
+
+void TeamConstraints::addTogether(const vector<string> &names)
+{
+    if (names.size() > 1)
+        togetherNames.push_back(names);
+}
+
+void TeamConstraints::addApart(const string &first, const string &second)
+{
+    apartNames.push_back({first, second});
+}
+
+bool TeamConstraints::empty() const
+{
+    return togetherNames.empty() && apartNames.empty();
+}
+
+// The constraints as text that depends only on their content, not on the file they came from.
+// Every name is written with its length, so no name can be mistaken for a separator.
+string TeamConstraints::canonical() const
+{
+    ostringstream ss;
+    for (const auto &names : togetherNames)
+    {
+        ss << "together";
+        for (const string &name : names)
+            ss << " " << name.size() << ":" << name;
+        ss << ";";
+    }
+    for (const auto &names : apartNames)
+        ss << "apart " << names.first.size() << ":" << names.first << " " << names.second.size() << ":" << names.second << ";";
+    return ss.str();
+}
+
+int TeamConstraints::findRoot(int person)
+{
+    while (parent[person] != person)
+    {
+        parent[person] = parent[parent[person]];
+        person = parent[person];
+    }
+    return person;
+}
+
+// Resolve the constraint names against the Persons and build the group and adjacency tables
+void TeamConstraints::bind(const vector<Person> &persons, int numTeams)
+{
+    int numPersons = persons.size();
+    this->numTeams = numTeams;
+
+    unordered_map<string, int> indexByName;
+    if (!empty())
+    {
+        indexByName.reserve(numPersons);
+        for (int i = 0; i < numPersons; ++i)
+        {
+            indexByName.emplace(persons[i].getName(), i);
+        }
+    }
+    auto lookup = [&](const string &name)
+    {
+        auto it = indexByName.find(name);
+        if (it == indexByName.end())
+            throw runtime_error("Constraint refers to unknown person \"" + name + "\"");
+        return it->second;
+    };
+
+    // Merge keep-together groups
+    parent.resize(numPersons);
+    iota(parent.begin(), parent.end(), 0);
+    for (const auto &names : togetherNames)
+    {
+        int first = findRoot(lookup(names[0]));
+        for (size_t i = 1; i < names.size(); ++i)
+        {
+            int other = findRoot(lookup(names[i]));
+            if (other != first)
+                parent[other] = first;
+        }
+    }
+
+    // Flatten the union-find into compact group ids with CSR member lists
+    group.assign(numPersons, -1);
+    vector<int> groupOfRoot(numPersons, -1);
+    int numGroups = 0;
+    for (int i = 0; i < numPersons; ++i)
+    {
+        int root = findRoot(i);
+        if (groupOfRoot[root] == -1)
+            groupOfRoot[root] = numGroups++;
+        group[i] = groupOfRoot[root];
+    }
+    groupOffsets.assign(numGroups + 1, 0);
+    for (int i = 0; i < numPersons; ++i)
+    {
+        groupOffsets[group[i] + 1]++;
+    }
+    partial_sum(groupOffsets.begin(), groupOffsets.end(), groupOffsets.begin());
+    groupPersons.resize(numPersons);
+    vector<int> cursor(groupOffsets.begin(), groupOffsets.end() - 1);
+    for (int i = 0; i < numPersons; ++i)
+    {
+        groupPersons[cursor[group[i]]++] = i;
+    }
+
+    // Give every group in a keep-apart pair a compact id and build the bitset adjacency
+    apartId.assign(numGroups, -1);
+    apartGroup.clear();
+    vector<pair<int, int>> apartGroups;
+    int numApart = 0;
+    for (const auto &names : apartNames)
+    {
+        int first = group[lookup(names.first)];
+        int second = group[lookup(names.second)];
+        if (first == second)
+        {
+            throw runtime_error("\"" + names.first + "\" and \"" + names.second + "\" are both kept together and kept apart");
+        }
+        if (apartId[first] == -1)
+        {
+            apartId[first] = numApart++;
+            apartGroup.push_back(first);
+        }
+        if (apartId[second] == -1)
+        {
+            apartId[second] = numApart++;
+            apartGroup.push_back(second);
+        }
+        apartGroups.push_back({apartId[first], apartId[second]});
+    }
+
+    apartWords = (numApart + 63) / 64;
+    apartBits.assign((size_t)numApart * apartWords, 0);
+    apartNeighbours.assign(numApart, {});
+    for (const auto &pair : apartGroups)
+    {
+        uint64_t &word = apartBits[(size_t)pair.first * apartWords + pair.second / 64];
+        uint64_t bit = uint64_t(1) << (pair.second % 64);
+        if (word & bit)
+            continue; // duplicate pair
+        word |= bit;
+        apartBits[(size_t)pair.second * apartWords + pair.first / 64] |= uint64_t(1) << (pair.first % 64);
+        apartNeighbours[pair.first].push_back(pair.second);
+        apartNeighbours[pair.second].push_back(pair.first);
+    }
+
+    blocked.assign((size_t)numApart * numTeams, 0);
+    checkApartCliques();
+}
+
+// Groups that must all be kept apart from each other need a team each. Grow such a clique
+// greedily from every group with at least numTeams neighbours, most connected neighbours first,
+// and fail if one outgrows the teams. Cliques the greedy search misses are left to placement.
+void TeamConstraints::checkApartCliques() const
+{
+    auto linked = [&](int first, int second)
+    {
+        return (apartBits[(size_t)first * apartWords + second / 64] >> (second % 64)) & 1;
+    };
+    for (int id = 0; id < (int)apartNeighbours.size(); ++id)
+    {
+        if (apartNeighbours[id].size() < numTeams)
+            continue;
+        vector<int> candidates;
+        for (int neighbour : apartNeighbours[id])
+        {
+            if (apartNeighbours[neighbour].size() >= numTeams)
+                candidates.push_back(neighbour);
+        }
+        sort(candidates.begin(), candidates.end(), [&](int a, int b)
+             { return apartNeighbours[a].size() > apartNeighbours[b].size(); });
+
+        vector<int> clique{id};
+        for (int candidate : candidates)
+        {
+            bool linkedToAll = true;
+            for (int member : clique)
+            {
+                if (!linked(candidate, member))
+                {
+                    linkedToAll = false;
+                    break;
+                }
+            }
+            if (!linkedToAll)
+                continue;
+            clique.push_back(candidate);
+            if (clique.size() > numTeams)
+            {
+                throw runtime_error("Unable to satisfy the team constraints with " + to_string(numTeams) + " teams: " +
+                                    to_string(clique.size()) + " groups must all be kept apart");
+            }
+        }
+    }
+}
+
+// Forget all placements while keeping the resolved groups
+void TeamConstraints::clearPlacements()
+{
+    fill(blocked.begin(), blocked.end(), 0);
+}
+
+int TeamConstraints::numGroups() const
+{
+    return groupOffsets.empty() ? 0 : groupOffsets.size() - 1;
+}
+
+int TeamConstraints::groupOf(int person) const
+{
+    return group[person];
+}
+
+int TeamConstraints::groupSize(int groupIndex) const
+{
+    return groupOffsets[groupIndex + 1] - groupOffsets[groupIndex];
+}
+
+const int *TeamConstraints::groupMembers(int groupIndex) const
+{
+    return groupPersons.data() + groupOffsets[groupIndex];
+}
+
+// True if the Person is bound by a constraint and cannot be moved on their own
+bool TeamConstraints::isFixed(int person) const
+{
+    if (group.empty())
+        return false;
+    int groupIndex = group[person];
+    return groupSize(groupIndex) > 1 || apartId[groupIndex] != -1;
+}
+
+// Number of groups this group must be kept apart from
+int TeamConstraints::apartDegree(int groupIndex) const
+{
+    int id = apartId[groupIndex];
+    return id == -1 ? 0 : apartNeighbours[id].size();
+}
+
+// Groups this group must be kept apart from
+vector<int> TeamConstraints::apartNeighboursOf(int groupIndex) const
+{
+    vector<int> neighbours;
+    int id = apartId[groupIndex];
+    if (id == -1)
+        return neighbours;
+    for (int neighbour : apartNeighbours[id])
+    {
+        neighbours.push_back(apartGroup[neighbour]);
+    }
+    return neighbours;
+}
+
+// True if no keep-apart neighbour of the group is currently placed in the team
+bool TeamConstraints::canPlace(int groupIndex, int team) const
+{
+    int id = apartId[groupIndex];
+    return id == -1 || blocked[(size_t)id * numTeams + team] == 0;
+}
+
+// True if the two groups must be kept apart
+bool TeamConstraints::conflicts(int firstGroup, int secondGroup) const
+{
+    int first = apartId[firstGroup];
+    int second = apartId[secondGroup];
+    if (first == -1 || second == -1)
+        return false;
+    return (apartBits[(size_t)first * apartWords + second / 64] >> (second % 64)) & 1;
+}
+
+void TeamConstraints::place(int groupIndex, int team)
+{
+    int id = apartId[groupIndex];
+    if (id == -1)
+        return;
+    for (int neighbour : apartNeighbours[id])
+    {
+        blocked[(size_t)neighbour * numTeams + team]++;
+    }
+}
+
+void TeamConstraints::remove(int groupIndex, int team)
+{
+    int id = apartId[groupIndex];
+    if (id == -1)
+        return;
+    for (int neighbour : apartNeighbours[id])
+    {
+        blocked[(size_t)neighbour * numTeams + team]--;
+    }
+}
\ No newline at end of file
@@ -1,4 +1,11 @@
 #include "../include/TeamGenerator.h"
+#include "../include/TeamRanking.h"
+#include "../include/AnytimeOptimizer.h"
+#include "../include/AnnealingOptimizer.h"
+#include "../include/ExactPartitioner.h"
+#include "../include/TaskScheduler.h"
+#include "../include/ColumnarInput.h"
+#include "../include/LineReader.h"
 #include <fstream>
 #include <sstream>
 #include <iostream>
@@ -6,36 +13,206 @@
 #include <algorithm>
 #include <queue>
 #include <map>
+#include <stdexcept>
+#include <cmath>
+#include <unordered_map>
 using namespace std;
 
+// Number of data rows inspected to decide whether a category is numeric or categorical
+static const size_t TYPE_SAMPLE_ROWS = 64;
+
+// Data lines per parsing task of readPersonsFromFile(), and parsing tasks per scheduler thread
+// in every batch of lines read
+static const size_t PARSE_BLOCK_ROWS = 4096;
+static const int PARSE_BLOCKS_PER_THREAD = 4;
+
+// Minimum time between two improvements reported by refineTeams()
+static const double REFINE_REPORT_MS = 20.0;
+
+// Most trial moves and swaps placeGroups() makes, over all groups, to free a team before it
+// gives up
+static const int MAKE_ROOM_ATTEMPTS = 1 << 16;
+
+// Bitset of the numbers of people that some of the groups add up to, from 0 to limit. Groups of
+// one size are added in chunks of 1, 2, 4, ... groups, so the work is about limit / 64 words
+// per chunk.
+static vector<uint64_t> groupSums(const map<int, int> &groupsBySize, int limit)
+{
+    int words = limit / 64 + 1;
+    vector<uint64_t> sums(words, 0);
+    sums[0] = 1;
+    for (const auto &entry : groupsBySize)
+    {
+        int left = entry.second;
+        for (int chunk = 1; left > 0; chunk *= 2)
+        {
+            int count = min(chunk, left);
+            left -= count;
+            long long shift = (long long)entry.first * count;
+            if (shift > limit)
+                break;
+            int wordShift = shift / 64;
+            int bitShift = shift % 64;
+            for (int w = words - 1; w >= wordShift; --w)
+            {
+                uint64_t moved = sums[w - wordShift] << bitShift;
+                if (bitShift && w - wordShift > 0)
+                    moved |= sums[w - wordShift - 1] >> (64 - bitShift);
+                sums[w] |= moved;
+            }
+        }
+    }
+    if (limit % 64 != 63)
+        sums[words - 1] &= (uint64_t(1) << (limit % 64 + 1)) - 1;
+    return sums;
+}
+
 vector<string> TeamGenerator::getheaders()
 {
     return headers;
 }
 
+// Fields of a batch of data lines, parsed in parallel before they are added to the roster
+struct ParsedRows
+{
+    vector<string> names;
+    vector<vector<double>> numeric; // per category, empty for categorical ones
+    vector<vector<string>> text;    // per category, empty for numeric ones
+    vector<double> weightedScores;
+};
+
+// Score of one numeric cell, read digit by digit: every digit counts, the first '.' or ','
+// starts the fraction and a leading '-' negates, so "85%" reads as 85 and text as 0
+static double parseScore(string scoreStr)
+{
+    double score = 0.0;
+    try
+    {
+        // Trim whitespace
+        scoreStr.erase(0, scoreStr.find_first_not_of(" \t\r\n"));
+        scoreStr.erase(scoreStr.find_last_not_of(" \t\r\n") + 1);
+
+        if (!scoreStr.empty())
+        {
+            // Manual conversion
+            double val = 0.0;
+            double fractional = 0.0;
+            double div = 1.0;
+            bool decimal_point = false;
+            bool negative = false;
+
+            for (char c : scoreStr)
+            {
+                if (c == '-' && val == 0.0 && !decimal_point && !negative)
+                {
+                    negative = true;
+                }
+                else if (c == '.' || c == ',')
+                {
+                    decimal_point = true;
+                }
+                else if (c >= '0' && c <= '9')
+                {
+                    if (decimal_point)
+                    {
+                        div *= 10.0;
+                        fractional = fractional * 10.0 + (c - '0');
+                    }
+                    else
+                    {
+                        val = val * 10.0 + (c - '0');
+                    }
+                }
+            }
+
+            score = val + (fractional / div);
+            if (negative)
+                score = -score;
+        }
+    }
+    catch (...)
+    {
+        // Fallback to 0.0 if conversion fails
+        score = 0.0;
+    }
+    return score;
+}
+
+// Parse one data line into rows; weightOf holds the weight of every selected category
+static void parseRow(const string &line, const vector<bool> &categorical, const vector<bool> &selected, const vector<double> &weightOf, ParsedRows &rows)
+{
+    istringstream ss(line);
+    string name;
+    getline(ss, name, ',');
+    rows.names.push_back(name);
+
+    double weightedScore = 0.0;
+    for (int i = 0; i < categorical.size(); ++i)
+    {
+        string scoreStr;
+        getline(ss, scoreStr, ',');
+        if (categorical[i])
+        {
+            // Text categories are encoded and do not add to the weighted score
+            scoreStr.erase(0, scoreStr.find_first_not_of(" \t\r\n"));
+            scoreStr.erase(scoreStr.find_last_not_of(" \t\r\n") + 1);
+            rows.text[i].push_back(scoreStr);
+            continue;
+        }
+        double score = parseScore(scoreStr);
+        rows.numeric[i].push_back(score);
+
+        // Check if the current category is selected
+        if (selected[i])
+            weightedScore += score * weightOf[i];
+    }
+    rows.weightedScores.push_back(weightedScore);
+}
+
 // Class to create balanced teams
 void TeamGenerator::readPersonsFromFile(const string &filename, const vector<int> &categoryIndices, const vector<double> &weights)
 {
     string line;
-    ifstream file(filename);
+    LineReader file(filename); // plain or gzip-compressed CSV
 
     // if file doesn't exist
-    if (!file.is_open())
+    if (!file.isOpen())
     {
         cout << "Error: File \"" << filename << "\" doesn't exist." << endl;
         exit(0);
         return;
     }
     // if file is empty
-    if (file.peek() == ifstream::traits_type::eof())
+    if (file.atEnd())
     {
         cout << "Error: File \"" << filename << "\" is empty." << endl;
         exit(0);
         return;
     }
 
+    // Arrow IPC and Parquet files carry their own schema and column types
+    if (isColumnarFile(filename))
+    {
+        headers = readColumnarHeaders(filename);
+        int numCategories = headers.size() - 1;
+        vector<bool> selected(numCategories, false);
+        vector<double> weightOf(numCategories, 0.0);
+        for (int k = categoryIndices.size() - 1; k >= 0; --k)
+        {
+            if (categoryIndices[k] >= 0 && categoryIndices[k] < numCategories)
+            {
+                selected[categoryIndices[k]] = true;
+                weightOf[categoryIndices[k]] = weights[k];
+            }
+        }
+        readPersonsFromColumns(filename, selected, weightOf);
+        this->categoryIndices = categoryIndices;
+        this->weights = weights;
+        return;
+    }
+
     // Get the number of categories from the header line
-    getline(file, line);
+    file.getline(line);
     istringstream headerSS(line);
     string header;
     headers.clear(); // Clear the existing headers
@@ -45,98 +222,861 @@ void TeamGenerator::readPersonsFromFile(const string &filename, const vector<int
     }
     int numCategories = headers.size() - 1; // -1 to exclude the "Name" header
 
-    // Process the data lines
+    // Weight of every selected category (the first one given if a category repeats)
+    vector<bool> selected(numCategories, false);
+    vector<double> weightOf(numCategories, 0.0);
+    for (int k = categoryIndices.size() - 1; k >= 0; --k)
+    {
+        if (categoryIndices[k] >= 0 && categoryIndices[k] < numCategories)
+        {
+            selected[categoryIndices[k]] = true;
+            weightOf[categoryIndices[k]] = weights[k];
+        }
+    }
+
+    // Buffer the first rows to detect which categories hold text rather than numbers. Selected
+    // categories are always read as numbers, so a stray "N/A" never drops a weighted category.
+    vector<string> sampleLines;
+    while (sampleLines.size() < TYPE_SAMPLE_ROWS && file.getline(line))
+    {
+        sampleLines.push_back(line);
+    }
+    vector<bool> categorical(numCategories, false);
+    for (const auto &sampleLine : sampleLines)
+    {
+        istringstream ss(sampleLine);
+        string cell;
+        getline(ss, cell, ',');
+        for (int i = 0; i < numCategories && getline(ss, cell, ','); ++i)
+        {
+            if (!selected[i] && !isNumericCell(cell))
+                categorical[i] = true;
+        }
+    }
+    roster.reset(vector<string>(headers.begin() + 1, headers.end()), categorical);
+
+    // Process the data lines in batches: the lines of a batch are parsed in blocks on the
+    // TaskScheduler, then appended to the roster in file order
+    TaskScheduler &scheduler = TaskScheduler::instance();
+    int numBlocks = scheduler.size() * PARSE_BLOCKS_PER_THREAD;
     Persons.clear(); // Clear the existing Persons
-    while (getline(file, line))
+    vector<string> lines = move(sampleLines);
+    vector<ParsedRows> blocks(numBlocks);
+    bool more = true;
+    while (more)
     {
-        istringstream ss(line);
-        string name;
-        getline(ss, name, ',');
+        while (lines.size() < numBlocks * PARSE_BLOCK_ROWS && file.getline(line))
+        {
+            lines.push_back(line);
+        }
+        more = lines.size() == numBlocks * PARSE_BLOCK_ROWS;
 
-        vector<double> scores(numCategories, 0.0); // Initialize all scores to 0.0
-        double weightedScore = 0.0;
-        for (int i = 0; i < numCategories; ++i)
+        auto parseBlock = [&](int block)
         {
-            string scoreStr;
-            getline(ss, scoreStr, ',');
-            double score = 0.0;
-            try
+            ParsedRows &rows = blocks[block];
+            rows = ParsedRows();
+            rows.numeric.resize(numCategories);
+            rows.text.resize(numCategories);
+            size_t first = min(lines.size(), block * PARSE_BLOCK_ROWS);
+            size_t last = min(lines.size(), first + PARSE_BLOCK_ROWS);
+            for (size_t row = first; row < last; ++row)
             {
-                // Trim whitespace
-                scoreStr.erase(0, scoreStr.find_first_not_of(" \t\r\n"));
-                scoreStr.erase(scoreStr.find_last_not_of(" \t\r\n") + 1);
+                parseRow(lines[row], categorical, selected, weightOf, rows);
+            }
+        };
+        scheduler.parallelFor(0, numBlocks, parseBlock);
 
-                if (!scoreStr.empty())
+        for (const ParsedRows &rows : blocks)
+        {
+            for (size_t row = 0; row < rows.names.size(); ++row)
+            {
+                roster.addName(rows.names[row]);
+                for (int i = 0; i < numCategories; ++i)
                 {
-                    // Manual conversion
-                    double val = 0.0;
-                    double fractional = 0.0;
-                    double div = 1.0;
-                    bool decimal_point = false;
-                    bool negative = false;
-
-                    for (char c : scoreStr)
+                    if (categorical[i])
+                        roster.addCategory(i, rows.text[i][row]);
+                    else
+                        roster.addNumeric(i, rows.numeric[i][row]);
+                }
+                Persons.push_back(Person(rows.names[row], rows.weightedScores[row], Persons.size()));
+            }
+        }
+        lines.clear();
+    }
+
+    this->categoryIndices = categoryIndices; // Store the category indices
+    this->weights = weights;
+}
+
+// Fill the roster and Persons from an Arrow IPC or Parquet file: the first column holds the
+// names, text columns are categorical and the others numeric, as with CSV files. Selected text
+// columns are read as numbers, cell by cell.
+void TeamGenerator::readPersonsFromColumns(const string &filename, const vector<bool> &selected, const vector<double> &weightOf)
+{
+    vector<RosterColumn> columns = readColumnarFile(filename);
+    if (columns.empty())
+        throw runtime_error("File \"" + filename + "\" has no columns");
+    int numCategories = columns.size() - 1;
+    size_t numRows = columns[0].text ? columns[0].strings.size() : columns[0].numbers.size();
+
+    vector<bool> categorical(numCategories);
+    for (int i = 0; i < numCategories; ++i)
+    {
+        RosterColumn &column = columns[i + 1];
+        size_t length = column.text ? column.strings.size() : column.numbers.size();
+        if (length != numRows)
+            throw runtime_error("Column \"" + column.name + "\" of \"" + filename + "\" has " + to_string(length) + " rows, expected " + to_string(numRows));
+        if (column.text && selected[i])
+        {
+            column.numbers.resize(numRows);
+            for (size_t row = 0; row < numRows; ++row)
+                column.numbers[row] = parseScore(column.strings[row]);
+            column.strings = vector<string>();
+            column.text = false;
+        }
+        categorical[i] = column.text;
+    }
+    roster.reset(vector<string>(headers.begin() + 1, headers.end()), categorical);
+
+    // Weighted scores column by column, then the columns move into the roster whole
+    vector<double> weightedScores(numRows, 0.0);
+    for (int i = 0; i < numCategories; ++i)
+    {
+        RosterColumn &column = columns[i + 1];
+        if (categorical[i])
+        {
+            for (const string &value : column.strings)
+                roster.addCategory(i, value);
+            continue;
+        }
+        if (selected[i])
+        {
+            for (size_t row = 0; row < numRows; ++row)
+                weightedScores[row] += column.numbers[row] * weightOf[i];
+        }
+        roster.setNumeric(i, move(column.numbers));
+    }
+
+    if (!columns[0].text)
+    {
+        for (double value : columns[0].numbers)
+        {
+            ostringstream ss;
+            ss << value;
+            columns[0].strings.push_back(ss.str());
+        }
+    }
+    roster.setNames(move(columns[0].strings));
+
+    Persons.clear();
+    Persons.reserve(numRows);
+    for (size_t row = 0; row < numRows; ++row)
+    {
+        Persons.push_back(Person(roster.getName(row), weightedScores[row], Persons.size()));
+    }
+}
+
+// Use already weighted scores instead of a file, e.g. columns handed over from Python: Person i
+// gets scores[i] and no name, and there is no roster, so constraints and diversity categories
+// cannot be used
+void TeamGenerator::setScores(const vector<double> &scores)
+{
+    headers.clear();
+    roster.reset({}, {});
+    categoryIndices.clear();
+    weights.clear();
+    Persons.clear();
+    Persons.reserve(scores.size());
+    for (size_t row = 0; row < scores.size(); ++row)
+    {
+        Persons.push_back(Person("", scores[row], row));
+    }
+}
+
+// Custom comparator for the priority queue
+struct PersonComparator
+{
+    bool operator()(const Person &s1, const Person &s2)
+    {
+        return s1.getScore() < s2.getScore();
+    }
+};
+
+const Roster &TeamGenerator::getRoster() const
+{
+    return roster;
+}
+
+// Balance the mix of these categorical categories (0-based category indices) across teams
+void TeamGenerator::setDiversityColumns(const vector<int> &columns)
+{
+    for (int column : columns)
+    {
+        if (column < 0 || column >= roster.numCategories() || !roster.isCategorical(column))
+        {
+            throw invalid_argument("Category " + to_string(column) + " is not a categorical column");
+        }
+    }
+    diversityColumns = columns;
+}
+
+void TeamGenerator::setConstraints(const TeamConstraints &constraints)
+{
+    this->constraints = constraints;
+}
+
+// Make refineTeams(), annealTeams() and partitionTeams() return early, with the best teams found
+// so far, once *stop is set (e.g. by another thread cancelling the request)
+void TeamGenerator::setStopFlag(const atomic<bool> *stop)
+{
+    stopFlag = stop;
+}
+
+// Order the keep-together groups by their total score in descending order
+vector<int> TeamGenerator::sortGroupsByScore(vector<double> &groupScores) const
+{
+    int numGroups = constraints.numGroups();
+    groupScores.assign(numGroups, 0.0);
+    for (int i = 0; i < Persons.size(); ++i)
+    {
+        groupScores[constraints.groupOf(i)] += Persons[i].getScore();
+    }
+
+    vector<int> order(numGroups);
+    for (int group = 0; group < numGroups; ++group)
+    {
+        order[group] = group;
+    }
+    stable_sort(order.begin(), order.end(), [&](int a, int b)
+                { return groupScores[a] > groupScores[b]; });
+    return order;
+}
+
+// Heap order of a team: smaller priorities are filled first
+pair<double, double> TeamGenerator::teamPriority(int size, double total)
+{
+    // With a maximum size or capacities the sizes may differ, so balance the total score first.
+    // Otherwise (also with only a minimum size) sizes stay within one of each other and totals
+    // are only compared between teams of equal size.
+    if (sizeBounds.maxSize > 0 || !sizeBounds.capacities.empty())
+        return {total, (double)size};
+    return {(double)size, total};
+}
+
+// True if every member of the group fits in the team's categorical diversity quotas
+bool TeamGenerator::groupWithinQuota(int group, int team) const
+{
+    if (histogram.empty())
+        return true;
+    const int *members = constraints.groupMembers(group);
+    for (int i = 0; i < constraints.groupSize(group); ++i)
+    {
+        if (!histogram.withinQuota(members[i], team))
+            return false;
+    }
+    return true;
+}
+
+// Capacity-aware heap assignment: each keep-together group without a team goes to the team with
+// the lowest priority that has room for it and holds none of its keep-apart neighbours. The
+// most constrained groups are placed first (groups with keep-apart neighbours, then the largest
+// groups), the others in the given order. Groups that already have a team in teamOf keep it,
+// unless a keep-apart neighbour was loaded into that team before them: those are placed again
+// like the others. Teams below their minimum size sit in a separate heap that takes over once
+// the people left are exactly enough to fill them. Teams over their categorical diversity quota
+// are only used when no other team can take the group, and when no team can, one placed group
+// is moved to another team to make room before giving up. Group sizes that cannot fill the teams
+// are rejected before anything is placed.
+void TeamGenerator::placeGroups(int numTeams, vector<int> &teamOf, const vector<int> &order, const vector<double> &groupScores)
+{
+    enum FitStatus
+    {
+        BLOCKED,
+        OVER_QUOTA,
+        FITS
+    };
+
+    int numPersons = Persons.size();
+    if (!diversityColumns.empty())
+    {
+        histogram.init(roster, diversityColumns, sizeBounds.targetSizes(numTeams, numPersons));
+    }
+    else
+    {
+        histogram = CategoryHistogram();
+    }
+
+    // Movable groups of every team: those without keep-apart neighbours by size (any one of a
+    // size frees the same seats), the others in a list. Groups that came with a team are never
+    // moved. A group taken out and put back at its old slot restores the exact order.
+    vector<int> sizes(numTeams, 0);
+    vector<double> totals(numTeams, 0.0);
+    vector<map<int, vector<int>>> freeBySize(numTeams);
+    vector<vector<int>> apartMovable(numTeams);
+    vector<int> slot(constraints.numGroups(), -1);
+    vector<bool> movable(constraints.numGroups(), true);
+    auto bucketOf = [&](int group, int team) -> vector<int> &
+    {
+        if (constraints.apartDegree(group) > 0)
+            return apartMovable[team];
+        return freeBySize[team][constraints.groupSize(group)];
+    };
+    auto assign = [&](int group, int team, int at = -1)
+    {
+        const int *members = constraints.groupMembers(group);
+        constraints.place(group, team);
+        sizes[team] += constraints.groupSize(group);
+        totals[team] += groupScores[group];
+        if (movable[group])
+        {
+            vector<int> &bucket = bucketOf(group, team);
+            if (at == -1 || at == bucket.size())
+            {
+                at = bucket.size();
+                bucket.push_back(group);
+            }
+            else
+            {
+                bucket.push_back(bucket[at]);
+                slot[bucket.back()] = bucket.size() - 1;
+                bucket[at] = group;
+            }
+            slot[group] = at;
+        }
+        for (int i = 0; i < constraints.groupSize(group); ++i)
+        {
+            teamOf[members[i]] = team;
+            if (!histogram.empty())
+                histogram.add(members[i], team);
+        }
+    };
+    auto unassign = [&](int group, int team)
+    {
+        const int *members = constraints.groupMembers(group);
+        constraints.remove(group, team);
+        sizes[team] -= constraints.groupSize(group);
+        totals[team] -= groupScores[group];
+        if (movable[group])
+        {
+            vector<int> &bucket = bucketOf(group, team);
+            int last = bucket.back();
+            bucket[slot[group]] = last;
+            slot[last] = slot[group];
+            bucket.pop_back();
+        }
+        for (int i = 0; i < constraints.groupSize(group); ++i)
+        {
+            if (!histogram.empty())
+                histogram.remove(members[i], team);
+        }
+    };
+
+    // Load the groups that already have a team; a split group follows its first placed member.
+    // Only the groups left without a team are ordered for placement below.
+    int remaining = 0;
+    vector<int> placement;
+    for (int group : order)
+    {
+        int groupSize = constraints.groupSize(group);
+        const int *members = constraints.groupMembers(group);
+        int team = -1;
+        for (int i = 0; i < groupSize && team == -1; ++i)
+        {
+            team = teamOf[members[i]];
+        }
+        if (team != -1 && !constraints.canPlace(group, team))
+        {
+            for (int i = 0; i < groupSize; ++i)
+                teamOf[members[i]] = -1;
+            team = -1;
+        }
+        if (team == -1)
+        {
+            remaining += groupSize;
+            placement.push_back(group);
+            continue;
+        }
+        movable[group] = false;
+        assign(group, team);
+    }
+
+    // Every team takes a number of people that some of the groups left add up to. If no such
+    // number fits a team's bounds, or the largest ones cannot hold everyone, fail before placing.
+    map<int, int> groupsBySize;
+    for (int group : placement)
+        groupsBySize[constraints.groupSize(group)]++;
+    if (groupsBySize.size() > 1 || (groupsBySize.size() == 1 && groupsBySize.begin()->first > 1))
+    {
+        vector<uint64_t> sums = groupSums(groupsBySize, remaining);
+        auto reachable = [&](int people)
+        { return (sums[people / 64] >> (people % 64)) & 1; };
+        long long capacity = 0;
+        for (int team = 0; team < numTeams; ++team)
+        {
+            int low = max(0, sizeBounds.minFor(team) - sizes[team]);
+            int high = min<long long>(remaining, (long long)sizeBounds.maxFor(team) - sizes[team]);
+            while (high >= low && !reachable(high))
+                --high;
+            if (high < low)
+            {
+                throw runtime_error("Unable to satisfy the team constraints with " + to_string(numTeams) +
+                                    " teams: the keep-together groups cannot fill team " + to_string(team + 1) + " within its size bounds");
+            }
+            capacity += high;
+        }
+        if (capacity < remaining)
+        {
+            throw runtime_error("Unable to satisfy the team constraints with " + to_string(numTeams) +
+                                " teams: the keep-together groups do not fit in the team sizes");
+        }
+    }
+
+    // Min-heaps of (priority, team index)
+    typedef pair<pair<double, double>, int> TeamLoad;
+    typedef priority_queue<TeamLoad, vector<TeamLoad>, greater<TeamLoad>> LoadHeap;
+    LoadHeap needy;
+    LoadHeap open;
+    int deficit = 0;
+    // Refill the heaps from the current sizes, leaving out one team (-1 for none)
+    auto fillHeaps = [&](int excluded)
+    {
+        needy = LoadHeap();
+        open = LoadHeap();
+        deficit = 0;
+        for (int team = 0; team < numTeams; ++team)
+        {
+            int minSize = sizeBounds.minFor(team);
+            deficit += max(0, minSize - sizes[team]);
+            if (team == excluded || sizes[team] >= sizeBounds.maxFor(team))
+                continue;
+            (sizes[team] < minSize ? needy : open).push(TeamLoad(teamPriority(sizes[team], totals[team]), team));
+        }
+    };
+    fillHeaps(-1);
+
+    // Make room for a group no team can take: move one movable group out of a team to another
+    // team, or swap it with a smaller movable group there, so that the group fits and the
+    // minimum sizes can still be reached. Teams are tried from the lowest total up. Only moves
+    // whose size change frees enough seats are tried, or, when a keep-apart neighbour blocks the
+    // team, moves of that neighbour. Returns the team made free, or -1 once no move helps or
+    // MAKE_ROOM_ATTEMPTS have been spent.
+    int attempts = 0;
+    auto makeRoom = [&](int group)
+    {
+        int groupSize = constraints.groupSize(group);
+        auto lack = [&](int team)
+        { return max(0, sizeBounds.minFor(team) - sizes[team]); };
+        int shortfall = 0;
+        for (int team = 0; team < numTeams; ++team)
+            shortfall += lack(team);
+
+        // Move blocker from team to other, in exchange for partner unless it is -1, and keep
+        // the move if the group then fits in team
+        auto tryMove = [&](int blocker, int team, int other, int partner)
+        {
+            ++attempts;
+            int lackBefore = lack(team) + lack(other);
+            int blockerSlot = slot[blocker];
+            int partnerSlot = partner == -1 ? -1 : slot[partner];
+            unassign(blocker, team);
+            if (partner != -1)
+                unassign(partner, other);
+            if (constraints.canPlace(blocker, other) && (partner == -1 || constraints.canPlace(partner, team)))
+            {
+                assign(blocker, other);
+                if (partner != -1)
+                    assign(partner, team);
+                int left = shortfall - lackBefore + lack(team) + lack(other) - min(groupSize, lack(team));
+                if (sizes[team] + groupSize <= sizeBounds.maxFor(team) && constraints.canPlace(group, team) && remaining - groupSize >= left)
+                    return true;
+                if (partner != -1)
+                    unassign(partner, team);
+                unassign(blocker, other);
+            }
+            if (partner != -1)
+                assign(partner, other, partnerSlot);
+            assign(blocker, team, blockerSlot);
+            return false;
+        };
+
+        // Keep-apart neighbours of the group in every team: -1 for none, -2 for several
+        vector<int> neighbourIn(numTeams, -1);
+        for (int neighbour : constraints.apartNeighboursOf(group))
+        {
+            int team = teamOf[constraints.groupMembers(neighbour)[0]];
+            if (team != -1)
+                neighbourIn[team] = neighbourIn[team] == -1 ? neighbour : -2;
+        }
+
+        vector<int> byTotal(numTeams);
+        for (int team = 0; team < numTeams; ++team)
+            byTotal[team] = team;
+        sort(byTotal.begin(), byTotal.end(), [&](int a, int b)
+             { return totals[a] < totals[b]; });
+        for (int team : byTotal)
+        {
+            // Seats the blocker must free beyond what its partner brings back
+            int need = groupSize - (sizeBounds.maxFor(team) - sizes[team]);
+            vector<int> blockers;
+            if (neighbourIn[team] == -2)
+                continue;
+            if (neighbourIn[team] != -1)
+            {
+                if (!movable[neighbourIn[team]])
+                    continue;
+                blockers.push_back(neighbourIn[team]);
+            }
+            else
+            {
+                for (auto it = freeBySize[team].lower_bound(max(need, 1)); it != freeBySize[team].end(); ++it)
+                {
+                    if (!it->second.empty())
+                        blockers.push_back(it->second.back());
+                }
+                for (int blocker : apartMovable[team])
+                {
+                    ++attempts;
+                    if (constraints.groupSize(blocker) >= need)
+                        blockers.push_back(blocker);
+                }
+            }
+
+            for (int blocker : blockers)
+            {
+                int blockerSize = constraints.groupSize(blocker);
+                for (int other : byTotal)
+                {
+                    if (other == team)
+                        continue;
+                    if (attempts >= MAKE_ROOM_ATTEMPTS)
+                        return -1;
+                    // Partner sizes that free need seats in team and still fit in other
+                    int lowest = blockerSize - (sizeBounds.maxFor(other) - sizes[other]);
+                    int highest = blockerSize - need;
+                    if (highest < max(lowest, 0))
+                    {
+                        ++attempts;
+                        continue;
+                    }
+                    if (lowest <= 0 && tryMove(blocker, team, other, -1))
+                        return team;
+                    for (auto it = freeBySize[other].lower_bound(max(lowest, 1)); it != freeBySize[other].end() && it->first <= highest; ++it)
+                    {
+                        if (!it->second.empty() && tryMove(blocker, team, other, it->second.back()))
+                            return team;
+                    }
+                    for (int i = 0; i < apartMovable[other].size() && attempts < MAKE_ROOM_ATTEMPTS; ++i)
                     {
-                        if (c == '-' && val == 0.0 && !decimal_point && !negative)
-                        {
-                            negative = true;
-                        }
-                        else if (c == '.' || c == ',')
-                        {
-                            decimal_point = true;
-                        }
-                        else if (c >= '0' && c <= '9')
-                        {
-                            if (decimal_point)
-                            {
-                                div *= 10.0;
-                                fractional = fractional * 10.0 + (c - '0');
-                            }
-                            else
-                            {
-                                val = val * 10.0 + (c - '0');
-                            }
-                        }
+                        int partner = apartMovable[other][i];
+                        int partnerSize = constraints.groupSize(partner);
+                        ++attempts;
+                        if (partnerSize >= lowest && partnerSize <= highest && tryMove(blocker, team, other, partner))
+                            return team;
                     }
+                }
+            }
+        }
+        return -1;
+    };
 
-                    score = val + (fractional / div);
-                    if (negative)
-                        score = -score;
+    // The most constrained groups first, the others in the given order
+    stable_sort(placement.begin(), placement.end(), [&](int a, int b)
+                {
+                    bool apartA = constraints.apartDegree(a) > 0;
+                    bool apartB = constraints.apartDegree(b) > 0;
+                    if (apartA != apartB)
+                        return apartA;
+                    return constraints.groupSize(a) > constraints.groupSize(b);
+                });
+
+    vector<pair<TeamLoad, bool>> skipped;
+    for (int group : placement)
+    {
+        int groupSize = constraints.groupSize(group);
+
+        auto fits = [&](const TeamLoad &load)
+        {
+            int team = load.second;
+            if (sizes[team] + groupSize > sizeBounds.maxFor(team) || !constraints.canPlace(group, team))
+                return BLOCKED;
+            return groupWithinQuota(group, team) ? FITS : OVER_QUOTA;
+        };
+
+        // Teams that cannot take this group are set aside, never revisited for the same group.
+        // The best team that only exceeds its diversity quota is remembered as a fallback.
+        skipped.clear();
+        int fallbackNeedy = -1;
+        int fallbackOpen = -1;
+        auto setAside = [&](LoadHeap &heap, bool isNeedy, int &fallback)
+        {
+            int status;
+            while (!heap.empty() && (status = fits(heap.top())) != FITS)
+            {
+                if (status == OVER_QUOTA && fallback == -1)
+                    fallback = skipped.size();
+                skipped.push_back({heap.top(), isNeedy});
+                heap.pop();
+            }
+        };
+        setAside(needy, true, fallbackNeedy);
+        bool forced = remaining - groupSize < deficit;
+        if (!forced)
+        {
+            setAside(open, false, fallbackOpen);
+        }
+
+        // Prefer a fitting heap top, then a fallback, taking the lower priority of the two heaps
+        int team = -1;
+        bool fromNeedy = !needy.empty() && (forced || open.empty() || needy.top() < open.top());
+        if (fromNeedy || (!forced && !open.empty()))
+        {
+            LoadHeap &source = fromNeedy ? needy : open;
+            team = source.top().second;
+            source.pop();
+        }
+        else
+        {
+            int fallback = fallbackNeedy;
+            if (!forced && fallbackOpen != -1 && (fallback == -1 || skipped[fallbackOpen].first < skipped[fallback].first))
+                fallback = fallbackOpen;
+            if (fallback != -1)
+            {
+                team = skipped[fallback].first.second;
+                skipped.erase(skipped.begin() + fallback);
+            }
+            else
+            {
+                team = makeRoom(group);
+                if (team == -1)
+                {
+                    throw runtime_error("Unable to satisfy the team constraints with " + to_string(numTeams) + " teams");
                 }
+                // Two teams changed size, so the set-aside teams and the heaps start over
+                skipped.clear();
+                fillHeaps(team);
             }
-            catch (...)
+        }
+
+        int minSize = sizeBounds.minFor(team);
+        deficit -= max(0, min(groupSize, minSize - sizes[team]));
+        remaining -= groupSize;
+        assign(group, team);
+
+        if (sizes[team] < sizeBounds.maxFor(team))
+        {
+            (sizes[team] < minSize ? needy : open).push(TeamLoad(teamPriority(sizes[team], totals[team]), team));
+        }
+        for (const auto &blockedLoad : skipped)
+        {
+            (blockedLoad.second ? needy : open).push(blockedLoad.first);
+        }
+    }
+}
+
+// Move single Persons out of the largest teams until every team reaches its minimum size and,
+// with balanceSizes, no two teams differ by more than one member. Each move takes the Person
+// whose score best evens out the two teams' totals. Returns the number of moves made.
+int TeamGenerator::repairTeamSizes(int numTeams, vector<int> &teamOf, bool balanceSizes)
+{
+    vector<vector<int>> teamMembers(numTeams);
+    vector<double> totals(numTeams, 0.0);
+    for (int i = 0; i < Persons.size(); ++i)
+    {
+        teamMembers[teamOf[i]].push_back(i);
+        totals[teamOf[i]] += Persons[i].getScore();
+    }
+    auto size = [&](int team)
+    { return (int)teamMembers[team].size(); };
+
+    int moves = 0;
+    while (true)
+    {
+        // The receiver is the team furthest below its minimum, or else the smallest team
+        int receiver = -1;
+        for (int team = 0; team < numTeams; ++team)
+        {
+            int shortfall = sizeBounds.minFor(team) - size(team);
+            if (shortfall > 0 && (receiver == -1 || shortfall > sizeBounds.minFor(receiver) - size(receiver)))
+                receiver = team;
+        }
+        bool belowMinimum = receiver != -1;
+        if (!belowMinimum && balanceSizes)
+        {
+            receiver = 0;
+            for (int team = 1; team < numTeams; ++team)
             {
-                // Fallback to 0.0 if conversion fails
-                score = 0.0;
+                if (size(team) < size(receiver))
+                    receiver = team;
             }
-            scores[i] = score;
+        }
+        if (receiver == -1)
+            break;
 
-            // Check if the current category is selected
-            auto categoryIndex = find(categoryIndices.begin(), categoryIndices.end(), i);
-            if (categoryIndex != categoryIndices.end())
+        // Donors must stay at or above their own minimum and, when only balancing, be two larger
+        vector<int> donors;
+        for (int team = 0; team < numTeams; ++team)
+        {
+            if (team != receiver && size(team) > sizeBounds.minFor(team) && (belowMinimum || size(team) > size(receiver) + 1))
+                donors.push_back(team);
+        }
+        if (donors.empty())
+        {
+            if (belowMinimum)
+                throw runtime_error("Unable to reach the minimum team sizes with the keep-together groups");
+            break;
+        }
+        sort(donors.begin(), donors.end(), [&](int a, int b)
+             { return size(a) > size(b); });
+
+        int bestDonor = -1;
+        int bestSlot = -1;
+        for (int donor : donors)
+        {
+            double target = (totals[donor] - totals[receiver]) / 2.0;
+            for (int slot = 0; slot < size(donor); ++slot)
             {
-                int weightIndex = categoryIndex - categoryIndices.begin();
-                weightedScore += score * weights[weightIndex];
+                int person = teamMembers[donor][slot];
+                int group = constraints.groupOf(person);
+                if (constraints.groupSize(group) != 1 || !constraints.canPlace(group, receiver))
+                    continue;
+                if (bestSlot == -1 || fabs(Persons[person].getScore() - target) < fabs(Persons[teamMembers[donor][bestSlot]].getScore() - target))
+                    bestSlot = slot;
             }
+            if (bestSlot != -1)
+            {
+                bestDonor = donor;
+                break;
+            }
+        }
+        if (bestDonor == -1)
+        {
+            if (belowMinimum)
+                throw runtime_error("Unable to reach the minimum team sizes with the keep-together groups");
+            break;
         }
+        int person = teamMembers[bestDonor][bestSlot];
+        int group = constraints.groupOf(person);
+        teamMembers[bestDonor][bestSlot] = teamMembers[bestDonor].back();
+        teamMembers[bestDonor].pop_back();
+        teamMembers[receiver].push_back(person);
+        totals[bestDonor] -= Persons[person].getScore();
+        totals[receiver] += Persons[person].getScore();
+        constraints.remove(group, bestDonor);
+        constraints.place(group, receiver);
+        teamOf[person] = receiver;
+        moves++;
+    }
+    return moves;
+}
+
+int TeamGenerator::getLastMoveCount() const
+{
+    return lastMoveCount;
+}
 
-        Persons.push_back(Person(name, weightedScore));
+// Build the teams from the assignment, listing members strongest group first
+vector<Team> TeamGenerator::collectTeams(int numTeams, const vector<int> &teamOf, const vector<int> &order)
+{
+    teams.clear();
+    teams.resize(numTeams);
+    for (int group : order)
+    {
+        const int *members = constraints.groupMembers(group);
+        for (int i = 0; i < constraints.groupSize(group); ++i)
+        {
+            teams[teamOf[members[i]]].addPerson(Persons[members[i]]);
+        }
     }
+    return teams;
+}
 
-    this->categoryIndices = categoryIndices; // Store the category indices
+vector<Team> TeamGenerator::assignGroups(int numTeams)
+{
+    sizeBounds.validate(numTeams, Persons.size());
+    constraints.bind(Persons, numTeams);
+    vector<double> groupScores;
+    vector<int> order = sortGroupsByScore(groupScores);
+
+    vector<int> teamOf(Persons.size(), -1);
+    placeGroups(numTeams, teamOf, order, groupScores);
+    repairTeamSizes(numTeams, teamOf, false);
+    return collectTeams(numTeams, teamOf, order);
 }
 
-// Custom comparator for the priority queue
-struct PersonComparator
+// Re-balance an earlier assignment after roster changes. People in previousTeams who are no
+// longer in the roster are dropped, roster entries missing from previousTeams are placed with
+// the heap engine, and teams left short are repaired with single moves, so everybody else
+// keeps their team. Kept people that a keep-apart constraint no longer allows together are
+// placed again and counted as moves. Beyond reading the roster and listing the teams, which
+// are linear, the work follows the change: only the new groups are sorted and placed, and
+// every repair move looks at the team sizes and the members of one donor team.
+vector<Team> TeamGenerator::rebalanceTeams(const vector<vector<string>> &previousTeams, const TeamSizeBounds &bounds)
 {
-    bool operator()(const Person &s1, const Person &s2)
+    int numTeams = previousTeams.size();
+    sizeBounds = bounds;
+    sizeBounds.validate(numTeams, Persons.size());
+    constraints.bind(Persons, numTeams);
+
+    unordered_map<string, int> indexByName;
+    indexByName.reserve(Persons.size());
+    for (int i = 0; i < Persons.size(); ++i)
     {
-        return s1.getScore() < s2.getScore();
+        indexByName.emplace(Persons[i].getName(), i);
     }
-};
+    vector<int> teamOf(Persons.size(), -1);
+    for (int team = 0; team < numTeams; ++team)
+    {
+        for (const auto &name : previousTeams[team])
+        {
+            auto it = indexByName.find(name);
+            if (it != indexByName.end() && teamOf[it->second] == -1)
+                teamOf[it->second] = team;
+        }
+    }
+    vector<int> previousTeamOf = teamOf;
 
-vector<Team> TeamGenerator::createTeams(int numTeams)
+    // Kept groups in roster order, then the new groups strongest first
+    int numGroups = constraints.numGroups();
+    vector<double> groupScores(numGroups, 0.0);
+    vector<bool> kept(numGroups, false);
+    for (int i = 0; i < Persons.size(); ++i)
+    {
+        groupScores[constraints.groupOf(i)] += Persons[i].getScore();
+        if (teamOf[i] != -1)
+            kept[constraints.groupOf(i)] = true;
+    }
+    vector<int> order;
+    vector<int> added;
+    for (int group = 0; group < numGroups; ++group)
+    {
+        (kept[group] ? order : added).push_back(group);
+    }
+    stable_sort(added.begin(), added.end(), [&](int a, int b)
+                { return groupScores[a] > groupScores[b]; });
+    order.insert(order.end(), added.begin(), added.end());
+
+    placeGroups(numTeams, teamOf, order, groupScores);
+    repairTeamSizes(numTeams, teamOf, !sizeBounds.isSet());
+
+    // Every Person who had a team and ends up in another one counts as a move, whichever step
+    // moved them
+    lastMoveCount = 0;
+    for (int i = 0; i < Persons.size(); ++i)
+    {
+        if (previousTeamOf[i] != -1 && teamOf[i] != previousTeamOf[i])
+            lastMoveCount++;
+    }
+    return collectTeams(numTeams, teamOf, order);
+}
+
+vector<Team> TeamGenerator::createTeams(int numTeams, const TeamSizeBounds &bounds)
 {
+    sizeBounds = bounds;
+    if (!constraints.empty() || sizeBounds.isSet() || !diversityColumns.empty())
+    {
+        return assignGroups(numTeams);
+    }
+
     // A priority queue to store Persons sorted by their scores in descending order
     priority_queue<Person, vector<Person>, PersonComparator> PersonPriorityQueue(Persons.begin(), Persons.end());
 
@@ -175,6 +1115,142 @@ vector<Team> TeamGenerator::createTeams(int numTeams)
     return teams;
 }
 
+// Team index of every Person in the teams of the last createTeams() call
+vector<int> TeamGenerator::currentAssignment() const
+{
+    vector<int> teamOf(Persons.size(), -1);
+    for (int team = 0; team < teams.size(); ++team)
+    {
+        for (const auto &person : teams[team].getmembers())
+        {
+            teamOf[person.getIndex()] = team;
+        }
+    }
+    return teamOf;
+}
+
+// Swap class of every Person for the optimizers: Persons bound by a constraint get -1 and stay
+// in their team, the others may be swapped with Persons sharing their values in every
+// diversity category, so team sizes, constraints and category mixes are kept
+vector<int> TeamGenerator::swapClasses() const
+{
+    vector<int> swapClass(Persons.size(), -1);
+    map<vector<uint16_t>, int> classOfCodes;
+    vector<uint16_t> codes(diversityColumns.size());
+    for (int i = 0; i < Persons.size(); ++i)
+    {
+        if (constraints.isFixed(i))
+            continue;
+        for (int column = 0; column < diversityColumns.size(); ++column)
+        {
+            codes[column] = roster.codes(diversityColumns[column])[i];
+        }
+        swapClass[i] = classOfCodes.emplace(codes, classOfCodes.size()).first->second;
+    }
+    return swapClass;
+}
+
+// Teams from a team index per Person, listing members in descending score order
+vector<Team> TeamGenerator::teamsFromAssignment(int numTeams, const vector<int> &teamOf) const
+{
+    vector<int> order(Persons.size());
+    for (int i = 0; i < Persons.size(); ++i)
+        order[i] = i;
+    stable_sort(order.begin(), order.end(), [&](int a, int b)
+                { return Persons[a].getScore() > Persons[b].getScore(); });
+
+    vector<Team> built(numTeams);
+    for (int person : order)
+    {
+        built[teamOf[person]].addPerson(Persons[person]);
+    }
+    return built;
+}
+
+// Improve the teams of the last createTeams() call with swaps until the deadline in milliseconds
+// (0 for none) or until no swap lowers the variance of the team scores. onImprove receives the
+// starting teams and then better ones as they are found.
+vector<Team> TeamGenerator::refineTeams(double deadlineMs, int threads, const function<void(const vector<Team> &, double, double)> &onImprove)
+{
+    int numTeams = teams.size();
+    vector<double> scores(Persons.size());
+    for (int i = 0; i < Persons.size(); ++i)
+    {
+        scores[i] = Persons[i].getScore();
+    }
+
+    AnytimeOptimizer optimizer(scores, swapClasses(), currentAssignment(), numTeams);
+    optimizer.setStopFlag(stopFlag);
+    if (onImprove)
+    {
+        optimizer.setListener([&](const vector<int> &assignment, double stddev, double elapsedMs)
+                              { onImprove(teamsFromAssignment(numTeams, assignment), stddev, elapsedMs); },
+                              REFINE_REPORT_MS);
+    }
+    teams = teamsFromAssignment(numTeams, optimizer.run(deadlineMs, max(1, threads)));
+    return teams;
+}
+
+// Split the Persons into teams of the sizes allowed by bounds with the smallest possible spread
+// between team scores, searching for up to limitMs milliseconds (see ExactPartitioner)
+vector<Team> TeamGenerator::partitionTeams(int numTeams, const TeamSizeBounds &bounds, double limitMs)
+{
+    sizeBounds = bounds;
+    vector<double> scores(Persons.size());
+    for (int i = 0; i < Persons.size(); ++i)
+    {
+        scores[i] = Persons[i].getScore();
+    }
+
+    ExactPartitioner partitioner(scores, sizeBounds.targetSizes(numTeams, Persons.size()));
+    partitioner.setStopFlag(stopFlag);
+    teams = teamsFromAssignment(numTeams, partitioner.solve(limitMs));
+    return teams;
+}
+
+// Balance the teams of the last createTeams() call on every selected numeric category at once
+// with simulated annealing, for the given number of iterations per thread (0 for the default)
+// or until the deadline in milliseconds (0 for none)
+vector<Team> TeamGenerator::annealTeams(long iterations, double deadlineMs, int threads)
+{
+    vector<const vector<double> *> columns;
+    vector<double> columnWeights;
+    vector<vector<double>> decoded(categoryIndices.size()); // columns not stored as doubles
+    if (weights.size() != categoryIndices.size())
+        throw invalid_argument("Every category needs one weight");
+    for (int i = 0; i < categoryIndices.size(); ++i)
+    {
+        int category = categoryIndices[i];
+        if (category < 0 || category >= roster.numCategories())
+            throw invalid_argument("Invalid category index " + to_string(category));
+        if (roster.isCategorical(category))
+            continue;
+        columns.push_back(&roster.numericValues(category, decoded[i]));
+        columnWeights.push_back(weights[i]);
+    }
+
+    AnnealingOptimizer optimizer(columns, columnWeights, swapClasses(), currentAssignment(), teams.size());
+    optimizer.setIterations(iterations);
+    optimizer.setStopFlag(stopFlag);
+    teams = teamsFromAssignment(teams.size(), optimizer.run(deadlineMs, max(1, threads)));
+    return teams;
+}
+
+// Split the Persons into groups, groups into sub-groups and so on, with fanOut[level] groups
+// per parent, balancing sizes, diversity mixes and scores within every parent (see
+// HierarchicalPartitioner). Constraints and team size bounds do not apply.
+HierarchyNode TeamGenerator::createHierarchy(const vector<int> &fanOut, int threads)
+{
+    vector<double> scores(Persons.size());
+    for (int i = 0; i < Persons.size(); ++i)
+    {
+        scores[i] = Persons[i].getScore();
+    }
+
+    HierarchicalPartitioner partitioner(scores, swapClasses(), fanOut);
+    return partitioner.run(max(1, threads));
+}
+
 void TeamGenerator::printTeamsWithWeights(const vector<Team> &teams)
 {
     for (int team = 0; team < teams.size(); team++)
@@ -231,91 +1307,9 @@ void TeamGenerator::printTeamsWithoutWeights(const vector<Team> &teams)
     } while (subChoice != 0);
 }
 
-void TeamGenerator::searchTeamsByCategory(int categoryIndex, const string &filename)
+void TeamGenerator::searchTeamsByCategory(int categoryIndex, int topK)
 {
-    // Check if the selected category was used to create the teams
-    bool categoryUsed = false;
-    for (int index : categoryIndices)
-    {
-        if (index == categoryIndex)
-        {
-            categoryUsed = true;
-            break;
-        }
-    }
-
-    if (!categoryUsed)
-    {
-        cout << "The selected category was not used to create the teams. Please choose another category." << endl;
-        return;
-    }
-
-    // Read the scores from the file
-    map<string, double> PersonScores;
-    ifstream file(filename);
-    if (file.is_open())
-    {
-        string line;
-        getline(file, line); // Skip the header row
-
-        while (getline(file, line))
-        {
-            istringstream ss(line);
-            string name;
-            vector<double> scores;
-            getline(ss, name, ',');
-            string scoreStr;
-            while (getline(ss, scoreStr, ','))
-            {
-                scores.push_back(stod(scoreStr));
-            }
-            PersonScores[name] = scores[categoryIndex + 1]; // Assuming 0-based category index
-        }
-        file.close();
-    }
-    else
-    {
-        cout << "Unable to open the file!" << endl;
-        return;
-    }
-
-    // Create a map to store teams and their total scores in the selected category
-    map<double, vector<int>, greater<double>> teamScores;
-    for (int team = 0; team < teams.size(); ++team)
-    {
-        double totalScore = 0.0;
-        for (const auto &Person : teams[team].getmembers())
-        {
-            totalScore += PersonScores[Person.getName()];
-        }
-        teamScores[totalScore].push_back(team);
-    }
-
-    cout << "Teams sorted by total score in " << headers[categoryIndex + 1] << " category (highest to lowest):" << endl;
-    int rank = 1;
-    for (const auto &teamScore : teamScores)
-    {
-        // Sort the teams with the same score using bubble sort
-        vector<int> sortedTeams = teamScore.second;
-        for (int i = 0; i < sortedTeams.size() - 1; ++i)
-        {
-            for (int j = 0; j < sortedTeams.size() - i - 1; ++j)
-            {
-                if (teams[sortedTeams[j]].getmembers().size() < teams[sortedTeams[j + 1]].getmembers().size())
-                {
-                    swap(sortedTeams[j], sortedTeams[j + 1]);
-                }
-            }
-        }
-
-        for (int teamIndex : sortedTeams)
-        {
-            cout << "Rank " << rank << ": Team " << teamIndex + 1 << " (Total Score: " << teamScore.first << "): ";
-            teams[teamIndex].printTeamWithoutWeights();
-            cout << endl;
-            ++rank;
-        }
-    }
+    printTeamRanking(teams, roster, categoryIndices, categoryIndex, topK);
 }
 
 void TeamGenerator::displayCategories()
@@ -0,0 +1,99 @@
+#include "../include/TeamProjection.h"
+#include <sstream>
+#include <stdexcept>
+#include <algorithm>
+using namespace std;
+
+bool TeamProjection::isSet() const
+{
+    return !members || size || score || teamOffset > 0 || teamLimit >= 0 || memberLimit >= 0;
+}
+
+int TeamProjection::firstTeam(int numTeams) const
+{
+    return min(teamOffset, numTeams);
+}
+
+int TeamProjection::endTeam(int numTeams) const
+{
+    if (teamLimit < 0)
+        return numTeams;
+    return min(numTeams, firstTeam(numTeams) + teamLimit);
+}
+
+// Print the selected teams as a JSON array of objects holding their team_number (counting from
+// the first team of the assignment, not of the page) and the selected fields
+void TeamProjection::printJson(ostream &os, const vector<Team> &teams) const
+{
+    int first = firstTeam(teams.size());
+    int end = endTeam(teams.size());
+    os << "[";
+    for (int i = first; i < end; ++i)
+    {
+        const vector<Person> &people = teams[i].getmembers();
+        if (i > first)
+            os << ",";
+        os << "{\"team_number\":" << (i + 1);
+        if (size)
+            os << ",\"size\":" << people.size();
+        if (score)
+        {
+            double total = 0.0;
+            for (const Person &person : people)
+                total += person.getScore();
+            os << ",\"score\":" << total;
+        }
+        if (members)
+        {
+            size_t shown = memberLimit < 0 ? people.size() : min(people.size(), (size_t)memberLimit);
+            os << ",\"members\":[";
+            for (size_t j = 0; j < shown; ++j)
+            {
+                if (j > 0)
+                    os << ",";
+                os << "\"" << people[j].getName() << "\"";
+            }
+            os << "]";
+        }
+        os << "}";
+    }
+    os << "]";
+}
+
+static int loadCount(const map<string, string> &options, const string &name, int fallback)
+{
+    auto it = options.find(name);
+    if (it == options.end() || it->second.empty())
+        return fallback;
+    int value = stoi(it->second);
+    if (value < 0)
+        throw invalid_argument("--" + name + " must not be negative");
+    return value;
+}
+
+TeamProjection loadTeamProjection(const map<string, string> &options)
+{
+    TeamProjection projection;
+    auto it = options.find("fields");
+    if (it != options.end())
+    {
+        projection.members = false;
+        istringstream ss(it->second);
+        string field;
+        while (getline(ss, field, ','))
+        {
+            if (field == "members")
+                projection.members = true;
+            else if (field == "size")
+                projection.size = true;
+            else if (field == "score")
+                projection.score = true;
+            else if (!field.empty())
+                throw invalid_argument("Unknown field '" + field + "'. Must be members, size or score");
+        }
+    }
+    projection.teamOffset = loadCount(options, "team-offset", 0);
+    projection.teamLimit = loadCount(options, "team-limit", -1);
+    projection.memberLimit = loadCount(options, "member-limit", -1);
+    return projection;
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+#include "../include/TeamQuery.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+using namespace std;
+
+TeamQuery::TeamQuery(const TeamAggregates &aggregates, const Roster &roster) : aggregates(aggregates), roster(roster)
+{
+    personIndex.reserve(roster.size());
+    for (int person = 0; person < roster.size(); ++person)
+    {
+        personIndex.emplace(roster.getName(person), person);
+    }
+}
+
+void TeamQuery::checkNumeric(int category) const
+{
+    if (category < 0 || category >= roster.numCategories())
+    {
+        throw out_of_range("Invalid category index " + to_string(category));
+    }
+    if (roster.isCategorical(category))
+    {
+        throw invalid_argument("Category \"" + roster.getHeader(category) + "\" is not numeric");
+    }
+}
+
+// The k teams with the highest weighted sum of category totals, best first
+vector<pair<int, double>> TeamQuery::topWeighted(const vector<pair<int, double>> &weights, int k) const
+{
+    int numTeams = aggregates.getNumTeams();
+    vector<double> values(numTeams, 0.0);
+    for (const auto &weight : weights)
+    {
+        checkNumeric(weight.first);
+        const double *totals = aggregates.getTotals(weight.first).data();
+        double factor = weight.second;
+        double *out = values.data();
+        for (int team = 0; team < numTeams; ++team)
+        {
+            out[team] += factor * totals[team];
+        }
+    }
+
+    vector<pair<int, double>> ranked(numTeams);
+    for (int team = 0; team < numTeams; ++team)
+    {
+        ranked[team] = {team, values[team]};
+    }
+    auto better = [](const pair<int, double> &a, const pair<int, double> &b)
+    { return a.second != b.second ? a.second > b.second : a.first < b.first; };
+    if (k > 0 && k < numTeams)
+    {
+        partial_sort(ranked.begin(), ranked.begin() + k, ranked.end(), better);
+        ranked.resize(k);
+    }
+    else
+    {
+        sort(ranked.begin(), ranked.end(), better);
+    }
+    return ranked;
+}
+
+// Teams whose total in the category is within tolerance (a fraction, 0.05 = 5%) of the mean
+vector<pair<int, double>> TeamQuery::nearMean(int category, double tolerance) const
+{
+    checkNumeric(category);
+    int numTeams = aggregates.getNumTeams();
+    const double *totals = aggregates.getTotals(category).data();
+    double mean = 0.0;
+    for (int team = 0; team < numTeams; ++team)
+    {
+        mean += totals[team];
+    }
+    mean = numTeams > 0 ? mean / numTeams : 0.0;
+
+    // Evaluate the predicate over the whole column first, then gather the matches
+    double limit = fabs(mean) * tolerance;
+    vector<unsigned char> match(numTeams);
+    for (int team = 0; team < numTeams; ++team)
+    {
+        match[team] = fabs(totals[team] - mean) <= limit;
+    }
+
+    vector<pair<int, double>> result;
+    for (int team = 0; team < numTeams; ++team)
+    {
+        if (match[team])
+            result.push_back({team, totals[team]});
+    }
+    return result;
+}
+
+// Team index of the named Person, or -1 if nobody of that name is on a team
+int TeamQuery::teamOfPerson(const string &name) const
+{
+    auto it = personIndex.find(name);
+    return it == personIndex.end() ? -1 : aggregates.teamOf(it->second);
+}
\ No newline at end of file
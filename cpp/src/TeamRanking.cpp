@@ -0,0 +1,112 @@
+#include "../include/TeamRanking.h"
+#include "../include/TaskScheduler.h"
+#include <algorithm>
+#include <stdexcept>
+using namespace std;
+
+// Smallest number of teams whose statistics are computed on the TaskScheduler
+static const size_t PARALLEL_RANK_TEAMS = 256;
+
+// Multi-key order: total (descending), size (descending), variance (ascending), team number
+static bool rankBefore(const TeamRank &a, const TeamRank &b)
+{
+    if (a.total != b.total)
+        return a.total > b.total;
+    if (a.size != b.size)
+        return a.size > b.size;
+    if (a.variance != b.variance)
+        return a.variance < b.variance;
+    return a.team < b.team;
+}
+
+TeamRanking::TeamRanking(const vector<Team> &teams, const Roster &roster, int category)
+{
+    if (category < 0 || category >= roster.numCategories())
+    {
+        throw out_of_range("Invalid category index " + to_string(category));
+    }
+    if (roster.isCategorical(category))
+    {
+        throw invalid_argument("Category \"" + roster.getHeader(category) + "\" is not numeric");
+    }
+
+    // Totals are summed in the roster's total type: with fixed-point scores they are exact, so
+    // teams tie exactly when their members' scores add up to the same value
+    const vector<Roster::Stored> &scores = roster.numeric(category);
+    stats.resize(teams.size());
+    auto rankTeam = [&](int team)
+    {
+        const vector<Person> &members = teams[team].getmembers();
+        Roster::Total sum = 0;
+        double squares = 0.0;
+        for (const auto &member : members)
+        {
+            Roster::Stored score = scores[member.getIndex()];
+            sum += score;
+            double value = Roster::Traits::decode(score);
+            squares += value * value;
+        }
+        int size = members.size();
+        double total = Roster::Traits::decodeTotal(sum);
+        double mean = size > 0 ? total / size : 0.0;
+        stats[team] = {team, total, size, size > 0 ? squares / size - mean * mean : 0.0};
+    };
+    if (teams.size() >= PARALLEL_RANK_TEAMS)
+    {
+        TaskScheduler::instance().parallelFor(0, teams.size(), rankTeam);
+    }
+    else
+    {
+        for (int team = 0; team < teams.size(); ++team)
+            rankTeam(team);
+    }
+}
+
+const vector<TeamRank> &TeamRanking::getStats() const
+{
+    return stats;
+}
+
+// The k best teams in rank order (all teams when k is 0 or larger than the number of teams)
+vector<TeamRank> TeamRanking::top(int k) const
+{
+    vector<TeamRank> ranked = stats;
+    if (k > 0 && k < ranked.size())
+    {
+        partial_sort(ranked.begin(), ranked.begin() + k, ranked.end(), rankBefore);
+        ranked.resize(k);
+    }
+    else
+    {
+        sort(ranked.begin(), ranked.end(), rankBefore);
+    }
+    return ranked;
+}
+
+void printTeamRanking(const vector<Team> &teams, const Roster &roster, const vector<int> &categoryIndices, int categoryIndex, int topK)
+{
+    // Check if the selected category was used to create the teams
+    if (find(categoryIndices.begin(), categoryIndices.end(), categoryIndex) == categoryIndices.end())
+    {
+        cout << "The selected category was not used to create the teams. Please choose another category." << endl;
+        return;
+    }
+    if (roster.isCategorical(categoryIndex))
+    {
+        cout << "The selected category is not numeric. Please choose another category." << endl;
+        return;
+    }
+
+    // Rank the teams on their totals in the selected category
+    TeamRanking ranking(teams, roster, categoryIndex);
+
+    cout << "Teams sorted by total score in " << roster.getHeader(categoryIndex) << " category (highest to lowest):" << endl;
+    int rank = 1;
+    for (const auto &teamRank : ranking.top(topK))
+    {
+        cout << "Rank " << rank << ": Team " << teamRank.team + 1 << " (Total Score: " << teamRank.total << "): ";
+        teams[teamRank.team].printTeamWithoutWeights();
+        cout << endl;
+        ++rank;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#include "../include/TeamSizeBounds.h"
+#include <climits>
+#include <string>
+#include <stdexcept>
+using namespace std;
+
+bool TeamSizeBounds::isSet() const
+{
+    return minSize > 0 || maxSize > 0 || !capacities.empty();
+}
+
+int TeamSizeBounds::minFor(int team) const
+{
+    return capacities.empty() ? minSize : capacities[team];
+}
+
+int TeamSizeBounds::maxFor(int team) const
+{
+    if (!capacities.empty())
+        return capacities[team];
+    return maxSize > 0 ? maxSize : INT_MAX;
+}
+
+// Check that the bounds can hold exactly numPersons people in numTeams teams
+void TeamSizeBounds::validate(int numTeams, int numPersons) const
+{
+    if (numTeams <= 0)
+    {
+        throw invalid_argument("The number of teams must be positive");
+    }
+    if (!capacities.empty() && capacities.size() != numTeams)
+    {
+        throw invalid_argument("Expected " + to_string(numTeams) + " team capacities, got " + to_string(capacities.size()));
+    }
+    if (maxSize > 0 && minSize > maxSize)
+    {
+        throw invalid_argument("The minimum team size is larger than the maximum team size");
+    }
+
+    long long totalMin = 0;
+    long long totalMax = 0;
+    for (int team = 0; team < numTeams; ++team)
+    {
+        if (minFor(team) < 0)
+            throw invalid_argument("Team sizes must not be negative");
+        totalMin += minFor(team);
+        totalMax += maxFor(team);
+    }
+    if (totalMin > numPersons || totalMax < numPersons)
+    {
+        throw invalid_argument("Team size bounds cannot hold " + to_string(numPersons) + " people in " + to_string(numTeams) + " teams");
+    }
+}
+
+// Sizes as equal as the bounds allow: every team starts at its minimum and the remaining
+// people are dealt one per team per round to the teams that still have room
+vector<int> TeamSizeBounds::targetSizes(int numTeams, int numPersons) const
+{
+    validate(numTeams, numPersons);
+
+    vector<int> sizes(numTeams);
+    int remaining = numPersons;
+    for (int team = 0; team < numTeams; ++team)
+    {
+        sizes[team] = minFor(team);
+        remaining -= sizes[team];
+    }
+    while (remaining > 0)
+    {
+        for (int team = 0; team < numTeams && remaining > 0; ++team)
+        {
+            if (sizes[team] < maxFor(team))
+            {
+                sizes[team]++;
+                remaining--;
+            }
+        }
+    }
+    return sizes;
+}
\ No newline at end of file
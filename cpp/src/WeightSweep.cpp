@@ -0,0 +1,129 @@
+#include "../include/WeightSweep.h"
+#include "../include/TaskScheduler.h"
+#include <algorithm>
+#include <stdexcept>
+using namespace std;
+
+// Scenarios whose scores are computed together, and Persons per block of the kernel (a block
+// of every category column stays in cache while the scenarios of a block read it)
+static const int SCENARIO_BLOCK = 16;
+static const int PERSON_BLOCK = 512;
+
+WeightSweep::WeightSweep(const Roster &roster, const vector<int> &categoryIndices, const vector<vector<double>> &weightVectors)
+    : roster(roster), categoryIndices(categoryIndices), weightVectors(weightVectors)
+{
+    for (int category : categoryIndices)
+    {
+        if (category < 0 || category >= roster.numCategories())
+            throw invalid_argument("Invalid category index " + to_string(category));
+    }
+    for (const auto &weights : weightVectors)
+    {
+        if (weights.size() != categoryIndices.size())
+            throw invalid_argument("Every weight vector needs one weight per category");
+    }
+}
+
+// Weighted scores of scenarios [first, last): scores[(scenario - first) * size + person]. Text
+// categories score 0, as in TeamGenerator::readPersonsFromFile.
+void WeightSweep::computeScores(int first, int last, vector<double> &scores) const
+{
+    int numPersons = roster.size();
+    scores.assign((size_t)(last - first) * numPersons, 0.0);
+    for (int blockStart = 0; blockStart < numPersons; blockStart += PERSON_BLOCK)
+    {
+        int blockSize = min(PERSON_BLOCK, numPersons - blockStart);
+        for (int scenario = first; scenario < last; ++scenario)
+        {
+            double *out = &scores[(size_t)(scenario - first) * numPersons + blockStart];
+            for (int i = 0; i < categoryIndices.size(); ++i)
+            {
+                double weight = weightVectors[scenario][i];
+                if (weight == 0.0 || roster.isCategorical(categoryIndices[i]))
+                    continue;
+                const Roster::Stored *column = roster.numeric(categoryIndices[i]).data() + blockStart;
+                for (int person = 0; person < blockSize; ++person)
+                {
+                    out[person] += weight * Roster::Traits::decode(column[person]);
+                }
+            }
+        }
+    }
+}
+
+// Deal the Persons in descending score order to the teams in a zig-zag pattern
+void WeightSweep::snakeDraft(const double *scores, int numTeams, vector<int> &order, vector<int> &teamOf) const
+{
+    int numPersons = roster.size();
+    order.resize(numPersons);
+    for (int person = 0; person < numPersons; ++person)
+        order[person] = person;
+    stable_sort(order.begin(), order.end(), [&](int a, int b)
+                { return scores[a] > scores[b]; });
+
+    teamOf.resize(numPersons);
+    int currentTeam = 0;
+    bool forward = true;
+    for (int person : order)
+    {
+        teamOf[person] = currentTeam;
+        if (forward && ++currentTeam == numTeams)
+        {
+            forward = false;
+            currentTeam = numTeams - 1;
+        }
+        else if (!forward && --currentTeam == -1)
+        {
+            forward = true;
+            currentTeam = 0;
+        }
+    }
+}
+
+// Generate and measure the teams of every scenario, one task of the scheduler per block of scenarios
+void WeightSweep::run(int numTeams)
+{
+    if (numTeams <= 0)
+        throw invalid_argument("The number of teams must be positive");
+
+    int numScenarios = weightVectors.size();
+    results.clear();
+    results.resize(numScenarios);
+    int numBlocks = (numScenarios + SCENARIO_BLOCK - 1) / SCENARIO_BLOCK;
+    auto runBlock = [&](int block)
+    {
+        vector<double> scores;
+        vector<int> order;
+        vector<int> teamOf;
+        int first = block * SCENARIO_BLOCK;
+        int last = min(first + SCENARIO_BLOCK, numScenarios);
+        computeScores(first, last, scores);
+        for (int scenario = first; scenario < last; ++scenario)
+        {
+            snakeDraft(&scores[(size_t)(scenario - first) * roster.size()], numTeams, order, teamOf);
+            results[scenario].reset(new BalanceMetrics(TeamAggregates(teamOf, numTeams, roster), roster));
+        }
+    };
+    TaskScheduler::instance().parallelFor(0, numBlocks, runBlock);
+}
+
+void WeightSweep::printJson(ostream &os) const
+{
+    os << "[";
+    for (int scenario = 0; scenario < results.size(); ++scenario)
+    {
+        if (scenario > 0)
+            os << ",";
+        os << "{\"scenario\":" << scenario << ",\"weights\":[";
+        for (size_t i = 0; i < weightVectors[scenario].size(); ++i)
+        {
+            if (i > 0)
+                os << ",";
+            os << weightVectors[scenario][i];
+        }
+        os << "],\"metrics\":";
+        results[scenario]->printJson(os);
+        os << "}";
+    }
+    os << "]";
+}
\ No newline at end of file
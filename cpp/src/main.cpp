@@ -4,8 +4,8 @@
 #include "../include/Person.h"
 #include "../include/Team.h"
 #include "../include/TeamGenerator.h"
-#include "../include/RandomTeamGenerator.h"
-#include "../include/RandomCategoricalTeamGenerator.h"
+#include "../include/TeamRanking.h"
+#include "../include/AssignmentStrategy.h"
 #include "../include/Utilities.h"
 
 using namespace std;
@@ -23,158 +23,83 @@ int main()
     TeamGenerator teamGenerator;
     teamGenerator.readPersonsFromFile(filename, {}, {}); // Read the file and populate headers
 
+    vector<StrategyInfo> strategies = StrategyRegistry::instance().list();
+    int displayChoice = strategies.size() + 1;
+
     int choice;
     do
     {
         cout << "Main Menu:\n";
-        cout << "1. Generate teams randomly\n";
-        cout << "2. Generate teams using categories\n";
-        cout << "3. Generate teams randomly with categories\n";
-        cout << "4. Display categories\n";
+        for (int i = 0; i < strategies.size(); ++i)
+        {
+            cout << i + 1 << ". " << strategies[i].description << "\n";
+        }
+        cout << displayChoice << ". Display categories\n";
         cout << "0. Exit\n";
         cout << "Enter your choice: ";
         cin >> choice;
 
-        if (choice == 1)
+        if (choice == displayChoice)
         {
-            int numTeams;
-            cout << "Enter the number of teams: ";
-            cin >> numTeams;
-
-            RandomTeamGenerator randomTeamGenerator;
-            randomTeamGenerator.readPersonsFromFile(filename);
-            vector<Team> teams = randomTeamGenerator.createRandomTeams(numTeams);
-
-            drawLine();
-            printMessage("The Random Team Generator", 4);
-            drawLine();
-
-            for (int team = 0; team < teams.size(); ++team)
-            {
-                cout << "Team " << team + 1 << ": ";
-                teams[team].printTeamWithoutWeights();
-                cout << endl;
-            }
+            teamGenerator.displayCategories();
         }
-        else if (choice == 2)
+        else if (choice >= 1 && choice <= strategies.size())
         {
-            int numTeams;
-            cout << "Enter the number of teams: ";
-            cin >> numTeams;
-
-            int numCategories;
-            cout << "Enter the number of categories: ";
-            cin >> numCategories;
-
-            vector<int> categoryIndices(numCategories);
-            cout << "Enter the category indices (0-based, separated by spaces): ";
-            for (int i = 0; i < numCategories; ++i)
-            {
-                cin >> categoryIndices[i];
-            }
-
-            vector<double> weights(numCategories);
-            double weightSum = 0.0;
-            cout << "Enter the weights for the selected categories (separated by spaces): ";
-            for (int i = 0; i < numCategories; ++i)
-            {
-                cin >> weights[i];
-                weightSum += weights[i];
-            }
+            const StrategyInfo &info = strategies[choice - 1];
 
-            if (abs(weightSum - 1.0) > 1e-9)
-            {
-                cout << "Error: The sum of weights should be 1.0" << endl;
-                continue;
-            }
-
-            teamGenerator.readPersonsFromFile(filename, categoryIndices, weights);
-            vector<Team> teams = teamGenerator.createTeams(numTeams);
-
-            drawLine();
-            printMessage("The Ultimate Team Generator", 4);
-            drawLine();
+            StrategyRequest request;
+            request.filename = filename;
+            cout << "Enter the number of teams: ";
+            cin >> request.numTeams;
 
-            int subChoice;
-            do
+            if (info.needsCategories)
             {
-                cout << "Sub-Menu:\n";
-                cout << "1. Print Teams with weights\n";
-                cout << "2. Print Teams without weights (in sorted order)\n";
-                cout << "3. Filter Teams on basis of category\n";
-                cout << "0. Return to Main Menu\n";
-                cout << "Enter your choice: ";
-                cin >> subChoice;
+                int numCategories;
+                cout << "Enter the number of categories: ";
+                cin >> numCategories;
 
-                if (subChoice == 1)
+                request.categoryIndices.resize(numCategories);
+                cout << "Enter the category indices (0-based, separated by spaces): ";
+                for (int i = 0; i < numCategories; ++i)
                 {
-                    teamGenerator.printTeamsWithWeights(teams);
+                    cin >> request.categoryIndices[i];
                 }
-                else if (subChoice == 2)
+
+                request.weights.resize(numCategories);
+                double weightSum = 0.0;
+                cout << "Enter the weights for the selected categories (separated by spaces): ";
+                for (int i = 0; i < numCategories; ++i)
                 {
-                    teamGenerator.printTeamsWithoutWeights(teams);
+                    cin >> request.weights[i];
+                    weightSum += request.weights[i];
                 }
-                else if (subChoice == 3)
-                {
-                    int categoryIndex;
-                    cout << "Enter the category index (0-based): ";
-                    cin >> categoryIndex;
 
-                    if (categoryIndex < 0 || categoryIndex >= teamGenerator.getheaders().size() - 1)
-                    {
-                        cout << "Invalid category index!" << endl;
-                    }
-                    else
-                    {
-                        teamGenerator.searchTeamsByCategory(categoryIndex, filename);
-                    }
+                if (abs(weightSum - 1.0) > 1e-9)
+                {
+                    cout << "Error: The sum of weights should be 1.0" << endl;
+                    continue;
                 }
-            } while (subChoice != 0);
-        }
-        else if (choice == 4)
-        {
-            teamGenerator.displayCategories();
-        }
-        else if (choice == 3)
-        {
-            int numTeams;
-            cout << "Enter the number of teams: ";
-            cin >> numTeams;
-
-            int numCategories;
-            cout << "Enter the number of categories: ";
-            cin >> numCategories;
-
-            vector<int> categoryIndices(numCategories);
-            cout << "Enter the category indices (0-based, separated by spaces): ";
-            for (int i = 0; i < numCategories; ++i)
-            {
-                cin >> categoryIndices[i];
             }
 
-            vector<double> weights(numCategories);
-            double weightSum = 0.0;
-            cout << "Enter the weights for the selected categories (separated by spaces): ";
-            for (int i = 0; i < numCategories; ++i)
-            {
-                cin >> weights[i];
-                weightSum += weights[i];
-            }
+            Roster roster;
+            unique_ptr<AssignmentStrategy> strategy = StrategyRegistry::instance().create(info.name);
+            vector<Team> teams = strategy->generate(request, &roster);
+
+            drawLine();
+            printMessage("The Team Generator: " + info.description, 4);
+            drawLine();
 
-            if (abs(weightSum - 1.0) > 1e-9)
+            if (!info.needsCategories)
             {
-                cout << "Error: The sum of weights should be 1.0" << endl;
+                for (int team = 0; team < teams.size(); ++team)
+                {
+                    cout << "Team " << team + 1 << ": ";
+                    teams[team].printTeamWithoutWeights();
+                    cout << endl;
+                }
                 continue;
             }
 
-            RandomCategoricalTeamGenerator randomCategoricalTeamGenerator;
-            randomCategoricalTeamGenerator.readPersonsFromFile(filename, categoryIndices, weights);
-            vector<Team> teams = randomCategoricalTeamGenerator.createTeams(numTeams);
-
-            drawLine();
-            printMessage("The Random Team Generator with Categories", 4);
-            drawLine();
-
             int subChoice;
             do
             {
@@ -188,11 +113,11 @@ int main()
 
                 if (subChoice == 1)
                 {
-                    randomCategoricalTeamGenerator.printTeamsWithWeights(teams);
+                    teamGenerator.printTeamsWithWeights(teams);
                 }
                 else if (subChoice == 2)
                 {
-                    randomCategoricalTeamGenerator.printTeamsWithoutWeights(teams);
+                    teamGenerator.printTeamsWithoutWeights(teams);
                 }
                 else if (subChoice == 3)
                 {
@@ -200,13 +125,13 @@ int main()
                     cout << "Enter the category index (0-based): ";
                     cin >> categoryIndex;
 
-                    if (categoryIndex < 0 || categoryIndex >= randomCategoricalTeamGenerator.getheaders().size() - 1)
+                    if (categoryIndex < 0 || categoryIndex >= teamGenerator.getheaders().size() - 1)
                     {
                         cout << "Invalid category index!" << endl;
                     }
                     else
                     {
-                        randomCategoricalTeamGenerator.searchTeamsByCategory(categoryIndex, filename);
+                        printTeamRanking(teams, roster, request.categoryIndices, categoryIndex);
                     }
                 }
             } while (subChoice != 0);
@@ -5,38 +5,93 @@
 #include <string>
 #include <map>
 #include <algorithm>
+#include <memory>
+#include <functional>
+#include <stdexcept>
 #include "../include/Person.h"
 #include "../include/Team.h"
 #include "../include/TeamGenerator.h"
 #include "../include/RandomTeamGenerator.h"
 #include "../include/RandomCategoricalTeamGenerator.h"
+#include "../include/TeamConstraints.h"
+#include "../include/TeamSizeBounds.h"
+#include "../include/TeamRanking.h"
+#include "../include/TeamAggregates.h"
+#include "../include/TeamQuery.h"
+#include "../include/BalanceMetrics.h"
+#include "../include/AssignmentStrategy.h"
+#include "../include/WeightSweep.h"
+#include "../include/HierarchicalPartitioner.h"
+#include "../include/TaskScheduler.h"
+#include "../include/AssignmentFile.h"
+#include "../include/SharedOutput.h"
+#include "../include/ResultCache.h"
+#include "../include/TeamProjection.h"
 using namespace std;
 
-void outputTeamsAsJson(const vector<Team> &teams)
+// Collect "--name=value" options and remove them from argv so positional arguments keep their indices
+map<string, string> extractOptions(int &argc, char *argv[])
 {
-    cout << "[";
-    for (size_t i = 0; i < teams.size(); ++i)
+    map<string, string> options;
+    int kept = 1;
+    for (int i = 1; i < argc; ++i)
     {
-        const Team &team = teams[i];
-        vector<Person> members = team.getmembers();
+        string arg = argv[i];
+        if (arg.rfind("--", 0) == 0)
+        {
+            size_t equals = arg.find('=');
+            string name = arg.substr(2, equals == string::npos ? string::npos : equals - 2);
+            options[name] = equals == string::npos ? "" : arg.substr(equals + 1);
+        }
+        else
+        {
+            argv[kept++] = argv[i];
+        }
+    }
+    argc = kept;
+    return options;
+}
 
+// Print the teams as JSON, only the fields and teams selected by projection
+void outputTeamsAsJson(const vector<Team> &teams, const TeamProjection &projection = TeamProjection())
+{
+    projection.printJson(cout, teams);
+}
+
+// Print a level of a hierarchy as JSON: every group with its size, total score and either its
+// sub-groups or, at the last level, its members
+void outputHierarchyAsJson(const vector<HierarchyNode> &groups, const Roster &roster)
+{
+    cout << "[";
+    for (size_t i = 0; i < groups.size(); ++i)
+    {
+        const HierarchyNode &group = groups[i];
         if (i > 0)
             cout << ",";
-        cout << "{\"team_number\":" << (i + 1) << ",\"members\":[";
-
-        for (size_t j = 0; j < members.size(); ++j)
+        cout << "{\"group_number\":" << (i + 1) << ",\"size\":" << group.members.size() << ",\"score\":" << group.total;
+        if (!group.children.empty())
         {
-            if (j > 0)
-                cout << ",";
-            cout << "\"" << members[j].getName() << "\"";
+            cout << ",\"groups\":";
+            outputHierarchyAsJson(group.children, roster);
         }
-        cout << "]}";
+        else
+        {
+            cout << ",\"members\":[";
+            for (size_t j = 0; j < group.members.size(); ++j)
+            {
+                if (j > 0)
+                    cout << ",";
+                cout << "\"" << roster.getName(group.members[j]) << "\"";
+            }
+            cout << "]";
+        }
+        cout << "}";
     }
     cout << "]";
 }
 
 // New function to search teams by category and output results as JSON
-void searchTeamsByCategoryJson(const vector<Team> &teams, int categoryIndex, const string &filename, const vector<int> &categoryIndices)
+void searchTeamsByCategoryJson(const vector<Team> &teams, int categoryIndex, const Roster &roster, const vector<int> &categoryIndices, int topK)
 {
     // Check if the selected category was used to create the teams
     bool categoryUsed = false;
@@ -54,137 +109,370 @@ void searchTeamsByCategoryJson(const vector<Team> &teams, int categoryIndex, con
         cout << "{\"error\":\"The selected category was not used to create the teams.\"}";
         return;
     }
+    if (categoryIndex < 0 || categoryIndex >= roster.numCategories() || roster.isCategorical(categoryIndex))
+    {
+        cout << "{\"error\":\"The selected category is not a numeric category.\"}";
+        return;
+    }
 
-    // Read the headers to get category name
-    string categoryName = "";
-    ifstream headerFile(filename);
-    if (headerFile.is_open())
+    // Rank the teams on their totals in the selected category
+    TeamRanking ranking(teams, roster, categoryIndex);
+    vector<TeamRank> ranked = ranking.top(topK);
+
+    // Output as JSON
+    cout << "{\"category_name\":\"" << roster.getHeader(categoryIndex) << "\",\"results\":[";
+    for (size_t i = 0; i < ranked.size(); ++i)
     {
-        string line;
-        if (getline(headerFile, line))
+        int teamIndex = ranked[i].team;
+
+        if (i > 0)
+            cout << ",";
+
+        cout << "{\"rank\":" << (i + 1)
+             << ",\"team_number\":" << (teamIndex + 1)
+             << ",\"score\":" << ranked[i].total
+             << ",\"members\":[";
+
+        const auto &members = teams[teamIndex].getmembers();
+        for (size_t j = 0; j < members.size(); ++j)
         {
-            istringstream headerSS(line);
-            string header;
-            vector<string> headers;
-            while (getline(headerSS, header, ','))
-            {
-                headers.push_back(header);
-            }
-            if (categoryIndex + 1 < headers.size())
-            {
-                categoryName = headers[categoryIndex + 1];
-            }
+            if (j > 0)
+                cout << ",";
+            cout << "{\"name\":\"" << members[j].getName()
+                 << "\",\"individual_score\":" << roster.getNumeric(categoryIndex, members[j].getIndex()) << "}";
         }
-        headerFile.close();
+        cout << "]}";
     }
+    cout << "]}";
+}
 
-    // Read the scores from the file
-    map<string, double> personScores;
-    ifstream file(filename);
-    if (file.is_open())
+// Parse a comma-separated list of integers such as category indices
+vector<int> parseIntList(const string &list)
+{
+    istringstream ss(list);
+    string item;
+    vector<int> values;
+    while (getline(ss, item, ','))
     {
-        string line;
-        getline(file, line); // Skip the header row
+        values.push_back(stoi(item));
+    }
+    return values;
+}
+
+// Parse a comma-separated list of numbers such as weights
+vector<double> parseDoubleList(const string &list)
+{
+    istringstream ss(list);
+    string item;
+    vector<double> values;
+    while (getline(ss, item, ','))
+    {
+        values.push_back(stod(item));
+    }
+    return values;
+}
+
+// Parse the weights of the generate command, reading each number by hand so that
+// malformed entries fall back to 0.0
+vector<double> parseWeights(const string &weights_str)
+{
+    istringstream weights_ss(weights_str);
+    string weight_str;
+    vector<double> weights;
 
-        while (getline(file, line))
+    while (getline(weights_ss, weight_str, ','))
+    {
+        try
         {
-            istringstream ss(line);
-            string name;
-            vector<double> scores;
-            getline(ss, name, ',');
-
-            // Read each score
-            int scoreIndex = 0;
-            string scoreStr;
-            while (getline(ss, scoreStr, ','))
+            // Trim whitespace
+            weight_str.erase(0, weight_str.find_first_not_of(" \t\r\n"));
+            weight_str.erase(weight_str.find_last_not_of(" \t\r\n") + 1);
+
+            // Handle empty string
+            if (weight_str.empty())
+            {
+                weights.push_back(0.0);
+                continue;
+            }
+
+            // Manual conversion
+            double val = 0.0;
+            double fractional = 0.0;
+            double div = 1.0;
+            bool decimal_point = false;
+            bool negative = false;
+
+            for (char c : weight_str)
             {
-                try
+                if (c == '-' && val == 0.0 && !decimal_point && !negative)
                 {
-                    double score = stod(scoreStr);
-                    if (scoreIndex == categoryIndex)
-                    {
-                        personScores[name] = score;
-                    }
+                    negative = true;
+                }
+                else if (c == '.' || c == ',')
+                {
+                    decimal_point = true;
                 }
-                catch (...)
+                else if (c >= '0' && c <= '9')
                 {
-                    // Handle conversion error
-                    if (scoreIndex == categoryIndex)
+                    if (decimal_point)
                     {
-                        personScores[name] = 0.0;
+                        div *= 10.0;
+                        fractional = fractional * 10.0 + (c - '0');
+                    }
+                    else
+                    {
+                        val = val * 10.0 + (c - '0');
                     }
                 }
-                scoreIndex++;
             }
+
+            double result = val + (fractional / div);
+            if (negative)
+                result = -result;
+            weights.push_back(result);
+        }
+        catch (...)
+        {
+            // Fallback to 0.0 if conversion fails
+            weights.push_back(0.0);
         }
-        file.close();
     }
-    else
+    return weights;
+}
+
+// Generate teams with the named strategy and, if roster is not null, fill it with the roster
+// holding their scores. Returns false for an unknown generation type.
+bool generateTeamsWithRoster(const string &generation_type, const string &filename, int num_teams, const vector<int> &categoryIndices,
+                             const vector<double> &weights, const map<string, string> &options, vector<Team> &teams, Roster *roster,
+                             const function<void(const vector<Team> &, double, double)> &onProgress = nullptr)
+{
+    unique_ptr<AssignmentStrategy> strategy = StrategyRegistry::instance().create(generation_type);
+    if (!strategy)
+        return false;
+
+    StrategyRequest request = buildStrategyRequest(filename, num_teams, categoryIndices, weights, options);
+    request.onProgress = onProgress;
+
+    // Repeatable requests are answered from the entry files in --cache-dir, when given; the
+    // cache holds teams only, so requests that need the roster skip it
+    auto cacheDir = options.find("cache-dir");
+    string cacheKey;
+    if (cacheDir != options.end() && !cacheDir->second.empty() && !roster && !onProgress)
+        cacheKey = ResultCache::requestKey(generation_type, request, options);
+    ResultCache cache(RESULT_CACHE_DEFAULT_BYTES, cacheKey.empty() ? "" : cacheDir->second);
+    shared_ptr<const vector<Team>> cached = cacheKey.empty() ? nullptr : cache.lookup(cacheKey);
+    if (cached)
     {
-        cout << "{\"error\":\"Unable to open the file!\"}";
-        return;
+        teams = *cached;
+        return true;
     }
 
-    // Create a map to store teams and their total scores in the selected category
-    vector<pair<int, double>> teamScores;
-    for (size_t team = 0; team < teams.size(); ++team)
+    teams = strategy->generate(request, roster);
+    if (!cacheKey.empty())
+        cache.store(cacheKey, teams);
+    return true;
+}
+
+// Print the registered strategies as JSON
+void outputStrategiesAsJson()
+{
+    vector<StrategyInfo> infos = StrategyRegistry::instance().list();
+    cout << "[";
+    for (size_t i = 0; i < infos.size(); ++i)
     {
-        double totalScore = 0.0;
-        for (const auto &person : teams[team].getmembers())
+        const StrategyInfo &info = infos[i];
+        if (i > 0)
+            cout << ",";
+        cout << "{\"name\":\"" << info.name << "\",\"description\":\"" << info.description << "\""
+             << ",\"needs_categories\":" << (info.needsCategories ? "true" : "false")
+             << ",\"deterministic\":" << (info.deterministic ? "true" : "false")
+             << ",\"supports_threads\":" << (info.supportsThreads ? "true" : "false")
+             << ",\"supports_deadline\":" << (info.supportsDeadline ? "true" : "false")
+             << ",\"parameters\":[";
+        for (size_t j = 0; j < info.parameters.size(); ++j)
         {
-            totalScore += personScores[person.getName()];
+            if (j > 0)
+                cout << ",";
+            cout << "\"" << info.parameters[j] << "\"";
         }
-        teamScores.push_back({team, totalScore});
+        cout << "]}";
     }
+    cout << "]";
+}
 
-    // Sort by score in descending order
-    sort(teamScores.begin(), teamScores.end(),
-         [](const pair<int, double> &a, const pair<int, double> &b)
-         {
-             return a.second > b.second;
-         });
+// Answer a query over generated teams as JSON. Supported queries:
+//   top <k> <cat:weight,...>           k best teams by a weighted sum of category totals
+//   near-mean <category> <tolerance>   teams whose category total is within tolerance of the mean
+//   person <name>                      the team holding the named person
+void runTeamQueryJson(const vector<Team> &teams, const Roster &roster, const vector<string> &query)
+{
+    TeamAggregates aggregates(teams, roster);
+    TeamQuery engine(aggregates, roster);
+    const vector<int> &sizes = aggregates.getSizes();
 
-    // Output as JSON
-    cout << "{\"category_name\":\"" << categoryName << "\",\"results\":[";
-    for (size_t i = 0; i < teamScores.size(); ++i)
+    auto outputResults = [&](const vector<pair<int, double>> &results)
     {
-        int teamIndex = teamScores[i].first;
-        double score = teamScores[i].second;
+        cout << "\"results\":[";
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            if (i > 0)
+                cout << ",";
+            cout << "{\"team_number\":" << (results[i].first + 1)
+                 << ",\"value\":" << results[i].second
+                 << ",\"size\":" << sizes[results[i].first] << "}";
+        }
+        cout << "]";
+    };
 
-        if (i > 0)
-            cout << ",";
+    const string &type = query[0];
+    if (type == "top" && query.size() == 3)
+    {
+        vector<pair<int, double>> weights;
+        istringstream ss(query[2]);
+        string item;
+        while (getline(ss, item, ','))
+        {
+            size_t colon = item.find(':');
+            weights.push_back({stoi(item.substr(0, colon)), colon == string::npos ? 1.0 : stod(item.substr(colon + 1))});
+        }
+        vector<pair<int, double>> results = engine.topWeighted(weights, stoi(query[1]));
+        cout << "{\"query\":\"top\",";
+        outputResults(results);
+        cout << "}";
+    }
+    else if (type == "near-mean" && query.size() == 3)
+    {
+        vector<pair<int, double>> results = engine.nearMean(stoi(query[1]), stod(query[2]));
+        cout << "{\"query\":\"near-mean\",";
+        outputResults(results);
+        cout << "}";
+    }
+    else if (type == "person" && query.size() == 2)
+    {
+        int team = engine.teamOfPerson(query[1]);
+        if (team == -1)
+        {
+            cout << "{\"error\":\"No team holds \\\"" << query[1] << "\\\".\"}";
+            return;
+        }
+        cout << "{\"query\":\"person\",\"name\":\"" << query[1] << "\",\"team_number\":" << (team + 1) << "}";
+    }
+    else
+    {
+        cout << "{\"error\":\"Unknown query. Use 'top <k> <cat:weight,...>', 'near-mean <category> <tolerance>' or 'person <name>'.\"}";
+    }
+}
 
-        cout << "{\"rank\":" << (i + 1)
-             << ",\"team_number\":" << (teamIndex + 1)
-             << ",\"score\":" << score
-             << ",\"members\":[";
+// Read an earlier assignment, one "team_number,name" line per person
+vector<vector<string>> readAssignmentFile(const string &filename)
+{
+    ifstream file(filename);
+    if (!file.is_open())
+    {
+        throw runtime_error("Unable to open assignment file \"" + filename + "\"");
+    }
 
-        const auto &members = teams[teamIndex].getmembers();
-        for (size_t j = 0; j < members.size(); ++j)
+    vector<vector<string>> previousTeams;
+    string line;
+    while (getline(file, line))
+    {
+        line.erase(remove(line.begin(), line.end(), '\r'), line.end());
+        size_t comma = line.find(',');
+        if (comma == string::npos)
+            continue;
+        int team = stoi(line.substr(0, comma)) - 1;
+        if (team < 0)
         {
-            if (j > 0)
-                cout << ",";
-            cout << "{\"name\":\"" << members[j].getName()
-                 << "\",\"individual_score\":" << personScores[members[j].getName()] << "}";
+            throw runtime_error("Invalid team number in assignment line \"" + line + "\"");
         }
-        cout << "]}";
+        if (team >= previousTeams.size())
+            previousTeams.resize(team + 1);
+        previousTeams[team].push_back(line.substr(comma + 1));
     }
-    cout << "]}";
+    return previousTeams;
+}
+
+// Read the weight vectors of a sweep: a file with one comma-separated vector per line, or the
+// vectors inline separated by ';'
+vector<vector<double>> readWeightMatrix(const string &source)
+{
+    vector<vector<double>> weightVectors;
+    ifstream file(source);
+    string row;
+    if (file.is_open())
+    {
+        while (getline(file, row))
+        {
+            row.erase(remove(row.begin(), row.end(), '\r'), row.end());
+            if (!row.empty() && row[0] != '#')
+                weightVectors.push_back(parseDoubleList(row));
+        }
+        return weightVectors;
+    }
+
+    istringstream rows(source);
+    while (getline(rows, row, ';'))
+    {
+        if (!row.empty())
+            weightVectors.push_back(parseDoubleList(row));
+    }
+    return weightVectors;
 }
 
 int main(int argc, char *argv[])
 {
+    map<string, string> options = extractOptions(argc, argv);
+
+    if (argc == 2 && string(argv[1]) == "strategies")
+    {
+        outputStrategiesAsJson();
+        return 0;
+    }
+
     if (argc < 3)
     {
-        cerr << "Usage: " << argv[0] << " <csv_file_path> <command> [<additional_args>...]" << endl;
+        cerr << "Usage: " << argv[0] << " strategies | <csv_file_path> <command> [<additional_args>...] [--constraints=<file>] [--min-size=<n>] [--max-size=<n>] [--capacities=<n,n,...>] [--diversity=<cat_indices>] [--metrics] [--threads=<n>] [--deadline-ms=<ms>] [--iterations=<n>] [--jitter=<stddevs>] [--seed=<n>] [--cache-dir=<dir>] [--fields=members,size,score] [--team-offset=<n>] [--team-limit=<n>] [--member-limit=<n>] [--stream] [--output=json|binary --output-file=<path> [--output-names]] [--output-shm=<name>] [--scheduler-stats]" << endl;
         return 1;
     }
 
     string filename = argv[1];
     string command = argv[2];
 
+    // With --output-shm, everything printed to stdout goes into a shared-memory segment that
+    // the caller maps; stdout itself only gets a short summary at the end
+    unique_ptr<SharedOutput> sharedOutput;
+    streambuf *stdoutBuffer = cout.rdbuf();
+    struct RestoreStdout
+    {
+        streambuf *buffer;
+        ~RestoreStdout()
+        {
+            cout.rdbuf(buffer);
+        }
+    } restoreStdout{stdoutBuffer};
+
     try
     {
+        // Size the shared scheduler before anything uses it
+        if (options.count("threads"))
+        {
+            int threads = stoi(options["threads"]);
+            if (threads < 1)
+                throw invalid_argument("--threads must be at least 1");
+            TaskScheduler::configure(threads);
+        }
+
+        if (options.count("output-shm"))
+        {
+            if (options.count("stream"))
+            {
+                cerr << "Shared-memory output cannot be streamed" << endl;
+                return 1;
+            }
+            sharedOutput.reset(new SharedOutput(options["output-shm"]));
+            cout.rdbuf(sharedOutput.get());
+        }
+
         if (command == "generate")
         {
             if (argc < 5)
@@ -196,183 +484,250 @@ int main(int argc, char *argv[])
             string generation_type = argv[3];
             int num_teams = stoi(argv[4]);
 
-            if (generation_type == "random")
+            unique_ptr<AssignmentStrategy> strategy = StrategyRegistry::instance().create(generation_type);
+            if (!strategy)
             {
-                RandomTeamGenerator generator;
-                generator.readPersonsFromFile(filename);
-                vector<Team> teams = generator.createRandomTeams(num_teams);
-                outputTeamsAsJson(teams);
+                cerr << "Invalid generation type. Must be one of " << StrategyRegistry::instance().names() << endl;
+                return 1;
             }
-            else if (generation_type == "categorical" || generation_type == "random_categorical")
+
+            vector<int> categoryIndices;
+            vector<double> weights;
+            if (strategy->info().needsCategories || argc >= 7)
             {
                 if (argc < 7)
                 {
                     cerr << "For categorical generation, category indices and weights are required" << endl;
                     return 1;
                 }
+                categoryIndices = parseIntList(argv[5]);
+                weights = parseWeights(argv[6]);
+            }
 
-                string cat_indices_str = argv[5];
-                string weights_str = argv[6];
+            bool withMetrics = options.count("metrics") > 0;
+            bool stream = options.count("stream") > 0;
+            TeamProjection projection = loadTeamProjection(options);
 
-                // Parse category indices
-                istringstream cat_ss(cat_indices_str);
-                string index_str;
-                vector<int> categoryIndices;
+            // With --output=binary, write the teams to --output-file (names only with --output-names)
+            // and print a short summary
+            bool binary = options.count("output") > 0 && options["output"] == "binary";
+            if (options.count("output") > 0 && options["output"] != "binary" && options["output"] != "json")
+            {
+                cerr << "Invalid output format. Must be 'json' or 'binary'" << endl;
+                return 1;
+            }
+            if (binary && (stream || options["output-file"].empty()))
+            {
+                cerr << "Binary output needs --output-file=<path> and cannot be streamed" << endl;
+                return 1;
+            }
 
-                while (getline(cat_ss, index_str, ','))
+            // With --stream, print every improvement as one NDJSON line, then a final line
+            function<void(const vector<Team> &, double, double)> onProgress;
+            if (stream)
+            {
+                onProgress = [&projection](const vector<Team> &teams, double stddev, double elapsedMs)
                 {
-                    categoryIndices.push_back(stoi(index_str));
-                }
-
-                // Parse weights
-                istringstream weights_ss(weights_str);
-                string weight_str;
-                vector<double> weights;
+                    cout << "{\"elapsed_ms\":" << elapsedMs << ",\"stddev\":" << stddev << ",\"teams\":";
+                    outputTeamsAsJson(teams, projection);
+                    cout << "}" << endl;
+                };
+            }
 
-                while (getline(weights_ss, weight_str, ','))
-                {
-                    try
-                    {
-                        // Trim whitespace
-                        weight_str.erase(0, weight_str.find_first_not_of(" \t\r\n"));
-                        weight_str.erase(weight_str.find_last_not_of(" \t\r\n") + 1);
-
-                        // Handle empty string
-                        if (weight_str.empty())
-                        {
-                            weights.push_back(0.0);
-                            continue;
-                        }
-
-                        // Manual conversion
-                        double val = 0.0;
-                        double fractional = 0.0;
-                        double div = 1.0;
-                        bool decimal_point = false;
-                        bool negative = false;
-
-                        for (char c : weight_str)
-                        {
-                            if (c == '-' && val == 0.0 && !decimal_point && !negative)
-                            {
-                                negative = true;
-                            }
-                            else if (c == '.' || c == ',')
-                            {
-                                decimal_point = true;
-                            }
-                            else if (c >= '0' && c <= '9')
-                            {
-                                if (decimal_point)
-                                {
-                                    div *= 10.0;
-                                    fractional = fractional * 10.0 + (c - '0');
-                                }
-                                else
-                                {
-                                    val = val * 10.0 + (c - '0');
-                                }
-                            }
-                        }
-
-                        double result = val + (fractional / div);
-                        if (negative)
-                            result = -result;
-                        weights.push_back(result);
-                    }
-                    catch (...)
-                    {
-                        // Fallback to 0.0 if conversion fails
-                        weights.push_back(0.0);
-                    }
-                }
+            vector<Team> teams;
+            Roster roster;
+            if (!generateTeamsWithRoster(generation_type, filename, num_teams, categoryIndices, weights, options, teams, withMetrics ? &roster : nullptr, onProgress))
+            {
+                cerr << "Invalid generation type. Must be one of " << StrategyRegistry::instance().names() << endl;
+                return 1;
+            }
 
-                if (generation_type == "categorical")
+            if (binary)
+            {
+                uint64_t bytes = writeAssignmentFile(options["output-file"], teams, withMetrics ? &roster : nullptr, options.count("output-names") > 0);
+                cout << "{\"format\":\"binary\",\"path\":\"" << options["output-file"] << "\",\"teams\":" << teams.size()
+                     << ",\"bytes\":" << bytes;
+                if (withMetrics)
                 {
-                    TeamGenerator generator;
-                    generator.readPersonsFromFile(filename, categoryIndices, weights);
-                    vector<Team> teams = generator.createTeams(num_teams);
-                    outputTeamsAsJson(teams);
+                    cout << ",\"metrics\":";
+                    BalanceMetrics(TeamAggregates(teams, roster), roster).printJson(cout);
                 }
-                else
+                cout << "}";
+            }
+            else if (stream)
+            {
+                cout << "{\"final\":true,\"teams\":";
+                outputTeamsAsJson(teams, projection);
+                if (withMetrics)
                 {
-                    RandomCategoricalTeamGenerator generator;
-                    generator.readPersonsFromFile(filename, categoryIndices, weights);
-                    vector<Team> teams = generator.createTeams(num_teams);
-                    outputTeamsAsJson(teams);
+                    cout << ",\"metrics\":";
+                    BalanceMetrics(TeamAggregates(teams, roster), roster).printJson(cout);
                 }
+                cout << "}" << endl;
+            }
+            else if (withMetrics)
+            {
+                cout << "{\"teams\":";
+                outputTeamsAsJson(teams, projection);
+                cout << ",\"metrics\":";
+                BalanceMetrics(TeamAggregates(teams, roster), roster).printJson(cout);
+                cout << "}";
             }
             else
             {
-                cerr << "Invalid generation type. Must be 'random', 'categorical', or 'random_categorical'" << endl;
-                return 1;
+                outputTeamsAsJson(teams, projection);
             }
         }
         else if (command == "search")
         {
-            if (argc < 7)
+            if (argc < 8)
             {
-                cerr << "For search: " << argv[0] << " <csv_file_path> search <generation_type> <num_teams> <category_index> <cat_indices> <weights>" << endl;
+                cerr << "For search: " << argv[0] << " <csv_file_path> search <generation_type> <num_teams> <category_index> <cat_indices> <weights> [--top=<k>]" << endl;
                 return 1;
             }
 
             string generation_type = argv[3];
             int num_teams = stoi(argv[4]);
             int category_index = stoi(argv[5]);
-            string cat_indices_str = argv[6];
-            string weights_str = argv[7];
+            vector<int> categoryIndices = parseIntList(argv[6]);
+            vector<double> weights = parseDoubleList(argv[7]);
 
-            // Parse category indices
-            istringstream cat_ss(cat_indices_str);
-            string index_str;
-            vector<int> categoryIndices;
+            vector<Team> teams;
+            Roster roster;
+            if (!generateTeamsWithRoster(generation_type, filename, num_teams, categoryIndices, weights, options, teams, &roster))
+            {
+                cerr << "Invalid generation type. Must be one of " << StrategyRegistry::instance().names() << endl;
+                return 1;
+            }
+
+            int topK = options.count("top") ? stoi(options["top"]) : 0;
+            searchTeamsByCategoryJson(teams, category_index, roster, categoryIndices, topK);
+        }
+        else if (command == "rebalance")
+        {
+            if (argc < 7)
+            {
+                cerr << "For rebalance: " << argv[0] << " <csv_file_path> rebalance <generation_type> <assignment_file> <cat_indices> <weights>" << endl;
+                return 1;
+            }
+
+            string generation_type = argv[3];
+            vector<vector<string>> previousTeams = readAssignmentFile(argv[4]);
+            vector<int> categoryIndices = parseIntList(argv[5]);
+            vector<double> weights = parseDoubleList(argv[6]);
 
-            while (getline(cat_ss, index_str, ','))
+            if (generation_type != "categorical" && generation_type != "random_categorical")
             {
-                categoryIndices.push_back(stoi(index_str));
+                cerr << "Invalid generation type. Must be 'categorical' or 'random_categorical'" << endl;
+                return 1;
             }
 
-            // Parse weights
-            istringstream weights_ss(weights_str);
-            string weight_str;
-            vector<double> weights;
+            unique_ptr<TeamGenerator> generator(generation_type == "categorical" ? new TeamGenerator() : new RandomCategoricalTeamGenerator());
+            generator->readPersonsFromFile(filename, categoryIndices, weights);
+            generator->setConstraints(loadConstraints(options));
+            generator->setDiversityColumns(loadDiversityColumns(options));
+            vector<Team> teams = generator->rebalanceTeams(previousTeams, loadSizeBounds(options));
 
-            while (getline(weights_ss, weight_str, ','))
+            cout << "{\"moves\":" << generator->getLastMoveCount() << ",\"teams\":";
+            outputTeamsAsJson(teams);
+            cout << "}";
+        }
+        else if (command == "sweep")
+        {
+            if (argc < 6)
             {
-                weights.push_back(stod(weight_str));
+                cerr << "For sweep: " << argv[0] << " <csv_file_path> sweep <num_teams> <cat_indices> <weight_vectors_file | w,w;w,w;...>" << endl;
+                return 1;
             }
 
-            vector<Team> teams;
+            int num_teams = stoi(argv[3]);
+            vector<int> categoryIndices = parseIntList(argv[4]);
+            vector<vector<double>> weightVectors = readWeightMatrix(argv[5]);
+
+            // Read the roster once; every scenario is scored from its columns, which are read as
+            // numbers because they are selected
+            TeamGenerator reader;
+            reader.readPersonsFromFile(filename, categoryIndices, vector<double>(categoryIndices.size(), 0.0));
+            WeightSweep sweep(reader.getRoster(), categoryIndices, weightVectors);
+            sweep.run(num_teams);
+            sweep.printJson(cout);
+        }
+        else if (command == "hierarchy")
+        {
+            if (argc < 4)
+            {
+                cerr << "For hierarchy: " << argv[0] << " <csv_file_path> hierarchy <groups_per_level> [<cat_indices> <weights>] [--diversity=<cat_indices>] [--threads=<n>] [--metrics]" << endl;
+                return 1;
+            }
 
-            if (generation_type == "random")
+            vector<int> fanOut = parseIntList(argv[3]);
+            vector<int> categoryIndices;
+            vector<double> weights;
+            if (argc >= 6)
             {
-                RandomTeamGenerator generator;
-                generator.readPersonsFromFile(filename);
-                teams = generator.createRandomTeams(num_teams);
+                categoryIndices = parseIntList(argv[4]);
+                weights = parseWeights(argv[5]);
             }
-            else if (generation_type == "categorical")
+            int threads = TaskScheduler::instance().size();
+
+            TeamGenerator generator;
+            generator.readPersonsFromFile(filename, categoryIndices, weights);
+            generator.setDiversityColumns(loadDiversityColumns(options));
+            HierarchyNode root = generator.createHierarchy(fanOut, threads);
+            const Roster &roster = generator.getRoster();
+
+            cout << "{\"levels\":[";
+            for (size_t i = 0; i < fanOut.size(); ++i)
             {
-                TeamGenerator generator;
-                generator.readPersonsFromFile(filename, categoryIndices, weights);
-                teams = generator.createTeams(num_teams);
+                if (i > 0)
+                    cout << ",";
+                cout << fanOut[i];
             }
-            else if (generation_type == "random_categorical")
+            cout << "],\"groups\":";
+            outputHierarchyAsJson(root.children, roster);
+            if (options.count("metrics"))
             {
-                RandomCategoricalTeamGenerator generator;
-                generator.readPersonsFromFile(filename, categoryIndices, weights);
-                teams = generator.createTeams(num_teams);
+                // Balance of all groups of each level, across parents
+                cout << ",\"metrics\":[";
+                for (int level = 0; level < fanOut.size(); ++level)
+                {
+                    int numGroups = 0;
+                    vector<int> groupOf = HierarchicalPartitioner::levelAssignment(root, level, roster.size(), numGroups);
+                    if (level > 0)
+                        cout << ",";
+                    BalanceMetrics(TeamAggregates(groupOf, numGroups, roster), roster).printJson(cout);
+                }
+                cout << "]";
             }
-            else
+            cout << "}";
+        }
+        else if (command == "query")
+        {
+            if (argc < 9)
+            {
+                cerr << "For query: " << argv[0] << " <csv_file_path> query <generation_type> <num_teams> <cat_indices> <weights> <query_type> <query_args>..." << endl;
+                return 1;
+            }
+
+            string generation_type = argv[3];
+            int num_teams = stoi(argv[4]);
+            vector<int> categoryIndices = parseIntList(argv[5]);
+            vector<double> weights = parseDoubleList(argv[6]);
+            vector<string> query(argv + 7, argv + argc);
+
+            vector<Team> teams;
+            Roster roster;
+            if (!generateTeamsWithRoster(generation_type, filename, num_teams, categoryIndices, weights, options, teams, &roster))
             {
-                cerr << "Invalid generation type. Must be 'random', 'categorical', or 'random_categorical'" << endl;
+                cerr << "Invalid generation type. Must be one of " << StrategyRegistry::instance().names() << endl;
                 return 1;
             }
 
-            searchTeamsByCategoryJson(teams, category_index, filename, categoryIndices);
+            runTeamQueryJson(teams, roster, query);
         }
         else
         {
-            cerr << "Unknown command. Must be 'generate' or 'search'" << endl;
+            cerr << "Unknown command. Must be 'generate', 'search', 'rebalance', 'sweep', 'hierarchy' or 'query'" << endl;
             return 1;
         }
     }
@@ -382,5 +737,27 @@ int main(int argc, char *argv[])
         return 1;
     }
 
+    if (sharedOutput)
+    {
+        try
+        {
+            cout.flush();
+            cout.rdbuf(stdoutBuffer);
+            uint64_t bytes = sharedOutput->finish();
+            cout << "{\"format\":\"shm\",\"name\":\"" << sharedOutput->getName() << "\",\"bytes\":" << bytes << "}";
+        }
+        catch (const exception &e)
+        {
+            cerr << "Error: " << e.what() << endl;
+            return 1;
+        }
+    }
+
+    // Utilization of the scheduler threads, on stderr so the JSON on stdout is unchanged
+    if (options.count("scheduler-stats"))
+    {
+        TaskScheduler::instance().printStatsJson(cerr);
+        cerr << endl;
+    }
     return 0;
 }
\ No newline at end of file
@@ -1,30 +1,67 @@
 #include <iostream>
-#include <fstream>
 #include <sstream>
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <stdexcept>
+#include "../include/ColumnarInput.h"
+#include "../include/LineReader.h"
 using namespace std;
 
 int main(int argc, char *argv[])
 {
     if (argc != 2)
     {
-        cerr << "Usage: " << argv[0] << " <csv_file_path>" << endl;
+        cerr << "Usage: " << argv[0] << " <csv_file_path | arrow_file_path | parquet_file_path>" << endl;
         return 1;
     }
 
     string filename = argv[1];
-    ifstream file(filename);
+    LineReader file(filename); // plain or gzip-compressed CSV
 
-    if (!file.is_open())
+    if (!file.isOpen())
     {
         cerr << "Error: Could not open file \"" << filename << "\"" << endl;
         return 1;
     }
 
+    // Arrow IPC and Parquet files list their columns in the schema
+    if (isColumnarFile(filename))
+    {
+        try
+        {
+            vector<string> headers = readColumnarHeaders(filename);
+            cout << "[";
+            for (size_t i = 0; i < headers.size(); ++i)
+            {
+                if (i > 0)
+                {
+                    cout << ",";
+                }
+                cout << "\"" << headers[i] << "\"";
+            }
+            cout << "]";
+        }
+        catch (const exception &e)
+        {
+            cerr << "Error: " << e.what() << endl;
+            return 1;
+        }
+        return 0;
+    }
+
     string line;
-    if (getline(file, line))
+    bool hasLine;
+    try
+    {
+        hasLine = file.getline(line);
+    }
+    catch (const exception &e)
+    {
+        cerr << "Error: " << e.what() << endl;
+        return 1;
+    }
+    if (hasLine)
     {
         // Remove any carriage returns or line feeds
         line.erase(remove(line.begin(), line.end(), '\r'), line.end());
@@ -0,0 +1,792 @@
+// Python module "team_maker": the generators in-process, without starting team_maker_api.exe.
+// Score columns are read in place through the buffer protocol (NumPy arrays, array.array,
+// memoryview, ...), the GIL is released while teams are assigned, and team members come back
+// as buffers of row indices that numpy.asarray() wraps without copying.
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include "../include/AssignmentStrategy.h"
+#include "../include/TeamGenerator.h"
+#include "../include/RandomTeamGenerator.h"
+#include "../include/RandomCategoricalTeamGenerator.h"
+#include "../include/LineReader.h"
+#include "../include/JobQueue.h"
+#include "../include/ResultCache.h"
+#include "../include/TeamProjection.h"
+#include <vector>
+#include <string>
+#include <map>
+#include <stdexcept>
+#include <cstdint>
+#include <algorithm>
+using namespace std;
+
+// Buffer of row indices returned to Python: a read-only 1-D buffer of int64 ("q")
+struct IndexArray
+{
+    PyObject_HEAD
+    vector<int64_t> *values;
+    Py_ssize_t shape;
+    Py_ssize_t stride;
+};
+
+static void IndexArray_dealloc(IndexArray *self)
+{
+    delete self->values;
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static int IndexArray_getbuffer(IndexArray *self, Py_buffer *view, int flags)
+{
+    if (flags & PyBUF_WRITABLE)
+    {
+        PyErr_SetString(PyExc_BufferError, "Index arrays are read-only");
+        view->obj = nullptr;
+        return -1;
+    }
+    self->shape = self->values->size();
+    self->stride = sizeof(int64_t);
+    view->obj = (PyObject *)self;
+    Py_INCREF(self);
+    view->buf = self->values->data();
+    view->len = self->shape * sizeof(int64_t);
+    view->readonly = 1;
+    view->itemsize = sizeof(int64_t);
+    view->format = (flags & PyBUF_FORMAT) ? (char *)"q" : nullptr;
+    view->ndim = 1;
+    view->shape = (flags & PyBUF_ND) ? &self->shape : nullptr;
+    view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? &self->stride : nullptr;
+    view->suboffsets = nullptr;
+    view->internal = nullptr;
+    return 0;
+}
+
+static Py_ssize_t IndexArray_length(IndexArray *self)
+{
+    return self->values->size();
+}
+
+static PyBufferProcs IndexArray_buffer = {(getbufferproc)IndexArray_getbuffer, nullptr};
+static PySequenceMethods IndexArray_sequence = {(lenfunc)IndexArray_length};
+
+static PyTypeObject IndexArrayType = {PyVarObject_HEAD_INIT(nullptr, 0) "team_maker.IndexArray"};
+
+static PyObject *newIndexArray(vector<int64_t> &&values)
+{
+    IndexArray *array = PyObject_New(IndexArray, &IndexArrayType);
+    if (!array)
+        return nullptr;
+    array->values = new vector<int64_t>(move(values));
+    return (PyObject *)array;
+}
+
+// Teams as (offsets, members): the members of team t are members[offsets[t]:offsets[t + 1]]
+static PyObject *teamsAsIndices(const vector<Team> &teams)
+{
+    vector<int64_t> offsets(1, 0);
+    vector<int64_t> members;
+    for (const Team &team : teams)
+    {
+        for (const Person &person : team.getmembers())
+            members.push_back(person.getIndex());
+        offsets.push_back(members.size());
+    }
+    PyObject *offsetArray = newIndexArray(move(offsets));
+    PyObject *memberArray = offsetArray ? newIndexArray(move(members)) : nullptr;
+    if (!memberArray)
+    {
+        Py_XDECREF(offsetArray);
+        return nullptr;
+    }
+    return Py_BuildValue("(NN)", offsetArray, memberArray);
+}
+
+// Raise the Python exception matching a C++ one: ValueError for invalid arguments
+static PyObject *raise(const string &message, bool invalidArgument)
+{
+    PyErr_SetString(invalidArgument ? PyExc_ValueError : PyExc_RuntimeError, message.c_str());
+    return nullptr;
+}
+
+// Add weight * column to scores for a column of C type T with the given byte stride
+template <typename T>
+static void addColumn(const char *data, Py_ssize_t stride, double weight, vector<double> &scores)
+{
+    for (size_t row = 0; row < scores.size(); ++row)
+        scores[row] += weight * *(const T *)(data + row * stride);
+}
+
+// Add weight * column to scores for a 1-D buffer in any native numeric format
+static bool addBuffer(const Py_buffer &view, double weight, vector<double> &scores)
+{
+    const char *format = view.format ? view.format : "B";
+    if (*format == '@' || *format == '=' || (*format == '<' && PY_LITTLE_ENDIAN) || ((*format == '>' || *format == '!') && PY_BIG_ENDIAN))
+        ++format;
+    if (format[0] == '\0' || format[1] != '\0')
+        return false;
+    const char *data = (const char *)view.buf;
+    Py_ssize_t stride = view.strides ? view.strides[0] : view.itemsize;
+    switch (format[0])
+    {
+    case 'd':
+        addColumn<double>(data, stride, weight, scores);
+        return true;
+    case 'f':
+        addColumn<float>(data, stride, weight, scores);
+        return true;
+    case 'b':
+        addColumn<signed char>(data, stride, weight, scores);
+        return true;
+    case 'B':
+        addColumn<unsigned char>(data, stride, weight, scores);
+        return true;
+    case '?':
+        addColumn<bool>(data, stride, weight, scores);
+        return true;
+    case 'h':
+        addColumn<short>(data, stride, weight, scores);
+        return true;
+    case 'H':
+        addColumn<unsigned short>(data, stride, weight, scores);
+        return true;
+    case 'i':
+        addColumn<int>(data, stride, weight, scores);
+        return true;
+    case 'I':
+        addColumn<unsigned int>(data, stride, weight, scores);
+        return true;
+    case 'l':
+        addColumn<long>(data, stride, weight, scores);
+        return true;
+    case 'L':
+        addColumn<unsigned long>(data, stride, weight, scores);
+        return true;
+    case 'q':
+        addColumn<long long>(data, stride, weight, scores);
+        return true;
+    case 'Q':
+        addColumn<unsigned long long>(data, stride, weight, scores);
+        return true;
+    }
+    return false;
+}
+
+// Buffers of the score columns held for the duration of a call
+struct ScoreColumns
+{
+    vector<Py_buffer> views;
+
+    ~ScoreColumns()
+    {
+        for (Py_buffer &view : views)
+            PyBuffer_Release(&view);
+    }
+};
+
+// Acquire the score columns: either one buffer of scores or a sequence of column buffers,
+// with one weight per column (1 each if weights is None)
+static bool acquireColumns(PyObject *scores, PyObject *weightList, ScoreColumns &columns, vector<double> &weights)
+{
+    vector<PyObject *> objects;
+    PyObject *sequence = nullptr;
+    if (PyObject_CheckBuffer(scores))
+        objects.push_back(scores);
+    else
+    {
+        sequence = PySequence_Fast(scores, "scores must be a buffer or a sequence of buffers");
+        if (!sequence)
+            return false;
+        for (Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE(sequence); ++i)
+            objects.push_back(PySequence_Fast_GET_ITEM(sequence, i));
+    }
+
+    bool ok = true;
+    for (PyObject *object : objects)
+    {
+        Py_buffer view;
+        if (PyObject_GetBuffer(object, &view, PyBUF_STRIDES | PyBUF_FORMAT) != 0)
+        {
+            ok = false;
+            break;
+        }
+        columns.views.push_back(view);
+        if (view.ndim != 1 || view.len / view.itemsize != columns.views[0].len / columns.views[0].itemsize)
+        {
+            PyErr_SetString(PyExc_ValueError, "Score columns must be one-dimensional and of the same length");
+            ok = false;
+            break;
+        }
+    }
+    Py_XDECREF(sequence);
+    if (!ok)
+        return false;
+    if (columns.views.empty())
+    {
+        PyErr_SetString(PyExc_ValueError, "No score columns given");
+        return false;
+    }
+
+    weights.assign(columns.views.size(), 1.0);
+    if (weightList && weightList != Py_None)
+    {
+        PyObject *weightSequence = PySequence_Fast(weightList, "weights must be a sequence of numbers");
+        if (!weightSequence)
+            return false;
+        if (PySequence_Fast_GET_SIZE(weightSequence) != (Py_ssize_t)weights.size())
+        {
+            Py_DECREF(weightSequence);
+            PyErr_SetString(PyExc_ValueError, "Expected one weight per score column");
+            return false;
+        }
+        for (size_t i = 0; i < weights.size(); ++i)
+            weights[i] = PyFloat_AsDouble(PySequence_Fast_GET_ITEM(weightSequence, i));
+        Py_DECREF(weightSequence);
+        if (PyErr_Occurred())
+            return false;
+    }
+    return true;
+}
+
+// Weighted scores of the acquired columns; false if a column has an unsupported format
+static bool weightedScores(const ScoreColumns &columns, const vector<double> &weights, vector<double> &scores)
+{
+    scores.assign(columns.views[0].len / columns.views[0].itemsize, 0.0);
+    for (size_t i = 0; i < columns.views.size(); ++i)
+    {
+        if (!addBuffer(columns.views[i], weights[i], scores))
+            return false;
+    }
+    return true;
+}
+
+// Shared body of categorical() and random_categorical()
+static PyObject *categoricalTeams(PyObject *args, PyObject *kwargs, bool random)
+{
+    static const char *keywords[] = {"scores", "num_teams", "weights", "jitter", nullptr};
+    static const char *plainKeywords[] = {"scores", "num_teams", "weights", nullptr};
+    PyObject *scoreObject;
+    int numTeams;
+    PyObject *weightList = nullptr;
+    double jitter = 0.0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, random ? "Oi|Od" : "Oi|O", (char **)(random ? keywords : plainKeywords), &scoreObject, &numTeams, &weightList, &jitter))
+        return nullptr;
+    if (numTeams <= 0)
+        return raise("num_teams must be positive", true);
+
+    ScoreColumns columns;
+    vector<double> weights;
+    if (!acquireColumns(scoreObject, weightList, columns, weights))
+        return nullptr;
+
+    vector<Team> teams;
+    string error;
+    bool invalidArgument = false;
+    bool supported = true;
+    Py_BEGIN_ALLOW_THREADS;
+    try
+    {
+        vector<double> scores;
+        supported = weightedScores(columns, weights, scores);
+        if (supported)
+        {
+            RandomCategoricalTeamGenerator randomGenerator;
+            TeamGenerator plainGenerator;
+            randomGenerator.setJitter(jitter);
+            TeamGenerator &generator = random ? randomGenerator : plainGenerator;
+            generator.setScores(scores);
+            teams = generator.createTeams(numTeams);
+        }
+    }
+    catch (const invalid_argument &e)
+    {
+        error = e.what();
+        invalidArgument = true;
+    }
+    catch (const exception &e)
+    {
+        error = e.what();
+    }
+    Py_END_ALLOW_THREADS;
+
+    if (!supported)
+        return raise("Unsupported score format; use a numeric type in native byte order", true);
+    if (!error.empty())
+        return raise(error, invalidArgument);
+    return teamsAsIndices(teams);
+}
+
+PyDoc_STRVAR(categorical_doc,
+             "categorical(scores, num_teams, weights=None) -> (offsets, members)\n\n"
+             "Balanced teams by score. scores is a buffer of scores or a sequence of column buffers\n"
+             "combined with weights. The members of team t are members[offsets[t]:offsets[t + 1]],\n"
+             "as row indices.");
+
+static PyObject *categoricalIndices(PyObject *, PyObject *args, PyObject *kwargs)
+{
+    return categoricalTeams(args, kwargs, false);
+}
+
+PyDoc_STRVAR(random_categorical_doc,
+             "random_categorical(scores, num_teams, weights=None, jitter=0.0) -> (offsets, members)\n\n"
+             "Like categorical(), but teams are drawn randomly within score tiers.");
+
+static PyObject *randomCategoricalIndices(PyObject *, PyObject *args, PyObject *kwargs)
+{
+    return categoricalTeams(args, kwargs, true);
+}
+
+PyDoc_STRVAR(random_doc,
+             "random(num_persons, num_teams, threads=1) -> (offsets, members)\n\n"
+             "Random teams of rows 0 .. num_persons - 1, as even in size as possible.");
+
+static PyObject *randomIndices(PyObject *, PyObject *args, PyObject *kwargs)
+{
+    static const char *keywords[] = {"num_persons", "num_teams", "threads", nullptr};
+    int numPersons;
+    int numTeams;
+    int threads = 1;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "ii|i", (char **)keywords, &numPersons, &numTeams, &threads))
+        return nullptr;
+    if (numPersons < 0 || numTeams <= 0)
+        return raise("num_persons must not be negative and num_teams must be positive", true);
+
+    vector<Team> teams;
+    string error;
+    Py_BEGIN_ALLOW_THREADS;
+    try
+    {
+        RandomTeamGenerator generator;
+        generator.setNumPersons(numPersons);
+        teams = generator.createRandomTeams(numTeams, TeamSizeBounds(), threads);
+    }
+    catch (const exception &e)
+    {
+        error = e.what();
+    }
+    Py_END_ALLOW_THREADS;
+
+    if (!error.empty())
+        return raise(error, true);
+    return teamsAsIndices(teams);
+}
+
+// Convert a sequence of numbers; false with a Python error set if it is not one
+template <typename T>
+static bool toVector(PyObject *object, vector<T> &values)
+{
+    if (!object || object == Py_None)
+        return true;
+    PyObject *sequence = PySequence_Fast(object, "expected a sequence of numbers");
+    if (!sequence)
+        return false;
+    for (Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE(sequence); ++i)
+    {
+        PyObject *item = PySequence_Fast_GET_ITEM(sequence, i);
+        values.push_back(is_integral<T>::value ? (T)PyLong_AsLong(item) : (T)PyFloat_AsDouble(item));
+    }
+    Py_DECREF(sequence);
+    return !PyErr_Occurred();
+}
+
+// Build the request of generate() and submit_job(); false with a Python error set if the
+// arguments are invalid. The roster file is checked here because the file readers end the
+// process on a missing or empty file.
+static bool buildRequest(const char *path, const char *generationType, int numTeams, PyObject *categoryList,
+                         PyObject *weightList, PyObject *optionDict, StrategyRequest &request, map<string, string> &options)
+{
+    vector<int> categoryIndices;
+    vector<double> weights;
+    if (!toVector(categoryList, categoryIndices) || !toVector(weightList, weights))
+        return false;
+    if (categoryIndices.size() != weights.size())
+        return raise("Expected one weight per category", true);
+
+    if (optionDict && optionDict != Py_None)
+    {
+        if (!PyDict_Check(optionDict))
+            return raise("options must be a dict", true);
+        PyObject *key;
+        PyObject *value;
+        Py_ssize_t position = 0;
+        while (PyDict_Next(optionDict, &position, &key, &value))
+        {
+            PyObject *keyText = PyObject_Str(key);
+            PyObject *valueText = keyText ? PyObject_Str(value) : nullptr;
+            if (valueText)
+                options[PyUnicode_AsUTF8(keyText)] = PyUnicode_AsUTF8(valueText);
+            Py_XDECREF(keyText);
+            Py_XDECREF(valueText);
+            if (PyErr_Occurred())
+                return false;
+        }
+    }
+
+    unique_ptr<AssignmentStrategy> strategy = StrategyRegistry::instance().create(generationType);
+    if (!strategy)
+        return raise("Invalid generation type. Must be one of " + StrategyRegistry::instance().names(), true);
+    if (strategy->info().needsCategories && categoryIndices.empty())
+        return raise("For categorical generation, category indices and weights are required", true);
+
+    try
+    {
+        LineReader reader(path);
+        if (!reader.isOpen())
+            throw invalid_argument(string("File \"") + path + "\" doesn't exist.");
+        if (reader.atEnd())
+            throw invalid_argument(string("File \"") + path + "\" is empty.");
+        request = buildStrategyRequest(path, numTeams, categoryIndices, weights, options);
+    }
+    catch (const exception &e)
+    {
+        return raise(e.what(), true);
+    }
+    return true;
+}
+
+// Teams as a list of member name lists
+static PyObject *teamsAsNames(const vector<Team> &teams)
+{
+    PyObject *result = PyList_New(teams.size());
+    for (size_t team = 0; result && team < teams.size(); ++team)
+    {
+        const vector<Person> &members = teams[team].getmembers();
+        PyObject *names = PyList_New(members.size());
+        if (!names)
+        {
+            Py_CLEAR(result);
+            break;
+        }
+        for (size_t i = 0; i < members.size(); ++i)
+        {
+            const string &name = members[i].getName();
+            PyList_SET_ITEM(names, i, PyUnicode_DecodeUTF8(name.data(), name.size(), "replace"));
+        }
+        PyList_SET_ITEM(result, team, names);
+    }
+    return result;
+}
+
+// The teams selected by projection as dicts holding "team_number" and the selected fields, the
+// way team_maker_api.exe prints them; only the names of the returned members are decoded
+static PyObject *teamsAsDicts(const vector<Team> &teams, const TeamProjection &projection)
+{
+    int first = projection.firstTeam(teams.size());
+    int end = projection.endTeam(teams.size());
+    PyObject *result = PyList_New(end - first);
+    for (int team = first; result && team < end; ++team)
+    {
+        const vector<Person> &members = teams[team].getmembers();
+        PyObject *dict = Py_BuildValue("{s:i}", "team_number", team + 1);
+        bool ok = dict != nullptr;
+        // Store value (a new reference) under name
+        auto set = [&](const char *name, PyObject *value)
+        {
+            ok = value && PyDict_SetItemString(dict, name, value) == 0;
+            Py_XDECREF(value);
+        };
+        if (ok && projection.size)
+            set("size", PyLong_FromSize_t(members.size()));
+        if (ok && projection.score)
+        {
+            double total = 0.0;
+            for (const Person &person : members)
+                total += person.getScore();
+            set("score", PyFloat_FromDouble(total));
+        }
+        if (ok && projection.members)
+        {
+            size_t shown = projection.memberLimit < 0 ? members.size() : min(members.size(), (size_t)projection.memberLimit);
+            PyObject *names = PyList_New(shown);
+            for (size_t i = 0; names && i < shown; ++i)
+            {
+                const string &name = members[i].getName();
+                PyList_SET_ITEM(names, i, PyUnicode_DecodeUTF8(name.data(), name.size(), "replace"));
+            }
+            set("members", names);
+        }
+        if (!ok)
+        {
+            Py_XDECREF(dict);
+            Py_CLEAR(result);
+            break;
+        }
+        PyList_SET_ITEM(result, team - first, dict);
+    }
+    return result;
+}
+
+// Teams of repeatable generate() requests, in memory only until configure_cache() is called
+static ResultCache &resultCache()
+{
+    static ResultCache cache;
+    return cache;
+}
+
+PyDoc_STRVAR(configure_cache_doc,
+             "configure_cache(max_bytes, directory=None)\n\n"
+             "Set the memory budget of the result cache of generate() and, with an existing directory,\n"
+             "also keep its entries there (shared with team_maker_api.exe --cache-dir).");
+
+static PyObject *configureCache(PyObject *, PyObject *args, PyObject *kwargs)
+{
+    static const char *keywords[] = {"max_bytes", "directory", nullptr};
+    unsigned long long maxBytes;
+    const char *directory = nullptr;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "K|z", (char **)keywords, &maxBytes, &directory))
+        return nullptr;
+    resultCache().configure(maxBytes, directory ? directory : "");
+    Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(cache_stats_doc, "cache_stats() -> dict\n\nHits and misses of the result cache of generate().");
+
+static PyObject *cacheStats(PyObject *, PyObject *)
+{
+    return Py_BuildValue("{s:l,s:l}", "hits", resultCache().getHits(), "misses", resultCache().getMisses());
+}
+
+PyDoc_STRVAR(generate_doc,
+             "generate(path, generation_type, num_teams, categories=None, weights=None, options=None) -> list\n\n"
+             "Teams from a roster file with any strategy of team_maker_api.exe, as a list of member\n"
+             "name lists. options maps the team_maker_api.exe option names without \"--\" (e.g.\n"
+             "\"min-size\", \"diversity\", \"threads\", \"deadline-ms\", \"seed\") to their values.\n"
+             "Teams of deterministic strategies and seeded random ones are cached. With any of the\n"
+             "options \"fields\", \"team-offset\", \"team-limit\" or \"member-limit\", the selected teams are\n"
+             "returned as dicts with \"team_number\" and the selected fields instead.");
+
+static PyObject *generateNames(PyObject *, PyObject *args, PyObject *kwargs)
+{
+    static const char *keywords[] = {"path", "generation_type", "num_teams", "categories", "weights", "options", nullptr};
+    const char *path;
+    const char *generationType;
+    int numTeams;
+    PyObject *categoryList = nullptr;
+    PyObject *weightList = nullptr;
+    PyObject *optionDict = nullptr;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "ssi|OOO", (char **)keywords, &path, &generationType, &numTeams, &categoryList, &weightList, &optionDict))
+        return nullptr;
+    StrategyRequest request;
+    map<string, string> options;
+    if (!buildRequest(path, generationType, numTeams, categoryList, weightList, optionDict, request, options))
+        return nullptr;
+    TeamProjection projection;
+    try
+    {
+        projection = loadTeamProjection(options);
+    }
+    catch (const exception &e)
+    {
+        return raise(e.what(), true);
+    }
+    auto result = [&](const vector<Team> &teams)
+    {
+        return projection.isSet() ? teamsAsDicts(teams, projection) : teamsAsNames(teams);
+    };
+
+    // Repeatable requests are answered from the result cache
+    string cacheKey = ResultCache::requestKey(generationType, request, options);
+    shared_ptr<const vector<Team>> cached = cacheKey.empty() ? nullptr : resultCache().lookup(cacheKey);
+    if (cached)
+        return result(*cached);
+
+    vector<Team> teams;
+
+    string error;
+    bool invalidArgument = false;
+    Py_BEGIN_ALLOW_THREADS;
+    try
+    {
+        teams = StrategyRegistry::instance().create(generationType)->generate(request, nullptr);
+        if (!cacheKey.empty())
+            resultCache().store(cacheKey, teams);
+    }
+    catch (const invalid_argument &e)
+    {
+        error = e.what();
+        invalidArgument = true;
+    }
+    catch (const exception &e)
+    {
+        error = e.what();
+    }
+    Py_END_ALLOW_THREADS;
+
+    if (!error.empty())
+        return raise(error, invalidArgument);
+    return result(teams);
+}
+
+// Background jobs of submit_job(), run by JOB_WORKERS threads with at most JOB_CAPACITY jobs
+// waiting; the results of the last JOB_KEEP_FINISHED finished jobs are kept until taken
+static const int JOB_WORKERS = 2;
+static const size_t JOB_CAPACITY = 64;
+static const size_t JOB_KEEP_FINISHED = 256;
+
+static JobQueue &jobQueue()
+{
+    static JobQueue queue(JOB_WORKERS, JOB_CAPACITY, JOB_KEEP_FINISHED);
+    return queue;
+}
+
+// Status of a job as a dict; stddev and error are None when there is none
+static PyObject *statusAsDict(const JobStatus &status)
+{
+    PyObject *result = Py_BuildValue("{s:l,s:s,s:i,s:i,s:l,s:d}", "id", status.id, "state", jobStateName(status.state),
+                                     "priority", status.priority, "queue_position", status.queuePosition,
+                                     "improvements", status.improvements, "elapsed_ms", status.elapsedMs);
+    if (!result)
+        return nullptr;
+    PyObject *stddev = status.stddev < 0 ? nullptr : PyFloat_FromDouble(status.stddev);
+    PyObject *error = status.error.empty() ? nullptr : PyUnicode_DecodeUTF8(status.error.data(), status.error.size(), "replace");
+    if (PyDict_SetItemString(result, "stddev", stddev ? stddev : Py_None) < 0 ||
+        PyDict_SetItemString(result, "error", error ? error : Py_None) < 0)
+        Py_CLEAR(result);
+    Py_XDECREF(stddev);
+    Py_XDECREF(error);
+    return result;
+}
+
+PyDoc_STRVAR(submit_job_doc,
+             "submit_job(path, generation_type, num_teams, categories=None, weights=None, options=None, priority=0) -> int\n\n"
+             "Queue generate() to run in the background and return the job id at once. Jobs with a\n"
+             "higher priority run first. Raises RuntimeError if the queue is full.");
+
+static PyObject *submitJob(PyObject *, PyObject *args, PyObject *kwargs)
+{
+    static const char *keywords[] = {"path", "generation_type", "num_teams", "categories", "weights", "options", "priority", nullptr};
+    const char *path;
+    const char *generationType;
+    int numTeams;
+    PyObject *categoryList = nullptr;
+    PyObject *weightList = nullptr;
+    PyObject *optionDict = nullptr;
+    int priority = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "ssi|OOOi", (char **)keywords, &path, &generationType, &numTeams, &categoryList, &weightList, &optionDict, &priority))
+        return nullptr;
+    StrategyRequest request;
+    map<string, string> options;
+    if (!buildRequest(path, generationType, numTeams, categoryList, weightList, optionDict, request, options))
+        return nullptr;
+    try
+    {
+        return PyLong_FromLong(jobQueue().submit(generationType, request, priority));
+    }
+    catch (const invalid_argument &e)
+    {
+        return raise(e.what(), true);
+    }
+    catch (const exception &e)
+    {
+        return raise(e.what(), false);
+    }
+}
+
+PyDoc_STRVAR(job_status_doc,
+             "job_status(job_id) -> dict\n\n"
+             "State (\"queued\", \"running\", \"done\", \"failed\" or \"cancelled\"), queue position,\n"
+             "improvements reported so far with the stddev of the last one, and elapsed time of a\n"
+             "job. Raises KeyError for unknown jobs.");
+
+static PyObject *jobStatus(PyObject *, PyObject *args)
+{
+    long id;
+    if (!PyArg_ParseTuple(args, "l", &id))
+        return nullptr;
+    JobStatus status;
+    if (!jobQueue().status(id, status))
+    {
+        PyErr_Format(PyExc_KeyError, "No job %ld", id);
+        return nullptr;
+    }
+    return statusAsDict(status);
+}
+
+PyDoc_STRVAR(cancel_job_doc,
+             "cancel_job(job_id) -> bool\n\n"
+             "Cancel a queued or running job; False if it does not exist or has already finished.");
+
+static PyObject *cancelJob(PyObject *, PyObject *args)
+{
+    long id;
+    if (!PyArg_ParseTuple(args, "l", &id))
+        return nullptr;
+    return PyBool_FromLong(jobQueue().cancel(id));
+}
+
+PyDoc_STRVAR(job_result_doc,
+             "job_result(job_id) -> dict\n\n"
+             "Like job_status(). Once the job has finished, the dict also holds its \"teams\" (member\n"
+             "name lists, empty unless the job is done) and the job is forgotten.");
+
+static PyObject *jobResult(PyObject *, PyObject *args)
+{
+    long id;
+    if (!PyArg_ParseTuple(args, "l", &id))
+        return nullptr;
+    vector<Team> teams;
+    JobStatus status;
+    if (!jobQueue().takeResult(id, teams, status))
+    {
+        PyErr_Format(PyExc_KeyError, "No job %ld", id);
+        return nullptr;
+    }
+    PyObject *result = statusAsDict(status);
+    if (result && status.state != JobState::Queued && status.state != JobState::Running)
+    {
+        PyObject *names = teamsAsNames(teams);
+        if (!names || PyDict_SetItemString(result, "teams", names) < 0)
+            Py_CLEAR(result);
+        Py_XDECREF(names);
+    }
+    return result;
+}
+
+PyDoc_STRVAR(strategies_doc, "strategies() -> list\n\nNames of the strategies generate() accepts.");
+
+static PyObject *strategyNames(PyObject *, PyObject *)
+{
+    vector<StrategyInfo> infos = StrategyRegistry::instance().list();
+    PyObject *result = PyList_New(infos.size());
+    for (size_t i = 0; result && i < infos.size(); ++i)
+        PyList_SET_ITEM(result, i, PyUnicode_FromString(infos[i].name.c_str()));
+    return result;
+}
+
+static PyMethodDef methods[] = {
+    {"generate", (PyCFunction)(void (*)(void))generateNames, METH_VARARGS | METH_KEYWORDS, generate_doc},
+    {"categorical", (PyCFunction)(void (*)(void))categoricalIndices, METH_VARARGS | METH_KEYWORDS, categorical_doc},
+    {"random_categorical", (PyCFunction)(void (*)(void))randomCategoricalIndices, METH_VARARGS | METH_KEYWORDS, random_categorical_doc},
+    {"random", (PyCFunction)(void (*)(void))randomIndices, METH_VARARGS | METH_KEYWORDS, random_doc},
+    {"strategies", strategyNames, METH_NOARGS, strategies_doc},
+    {"configure_cache", (PyCFunction)(void (*)(void))configureCache, METH_VARARGS | METH_KEYWORDS, configure_cache_doc},
+    {"cache_stats", cacheStats, METH_NOARGS, cache_stats_doc},
+    {"submit_job", (PyCFunction)(void (*)(void))submitJob, METH_VARARGS | METH_KEYWORDS, submit_job_doc},
+    {"job_status", jobStatus, METH_VARARGS, job_status_doc},
+    {"cancel_job", cancelJob, METH_VARARGS, cancel_job_doc},
+    {"job_result", jobResult, METH_VARARGS, job_result_doc},
+    {nullptr, nullptr, 0, nullptr}};
+
+static PyModuleDef moduleDef = {PyModuleDef_HEAD_INIT, "team_maker", "Balanced team generation without a subprocess", -1, methods};
+
+PyMODINIT_FUNC PyInit_team_maker()
+{
+    IndexArrayType.tp_basicsize = sizeof(IndexArray);
+    IndexArrayType.tp_dealloc = (destructor)IndexArray_dealloc;
+    IndexArrayType.tp_as_buffer = &IndexArray_buffer;
+    IndexArrayType.tp_as_sequence = &IndexArray_sequence;
+    IndexArrayType.tp_flags = Py_TPFLAGS_DEFAULT;
+    IndexArrayType.tp_doc = "Read-only buffer of int64 row indices";
+    if (PyType_Ready(&IndexArrayType) < 0)
+        return nullptr;
+
+    PyObject *module = PyModule_Create(&moduleDef);
+    if (!module)
+        return nullptr;
+    Py_INCREF(&IndexArrayType);
+    if (PyModule_AddObject(module, "IndexArray", (PyObject *)&IndexArrayType) < 0)
+    {
+        Py_DECREF(&IndexArrayType);
+        Py_DECREF(module);
+        return nullptr;
+    }
+    return module;
+}
\ No newline at end of file